@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------
+  File    : fr2z.c
+  Contents: mex gateway for Fisher's r-to-z transformation
+  Author  : Kristian Loewe
+
+  Usage   : z = fr2z(R [, nthreads])
+
+  R         correlation coefficients (any size, single or double)
+  nthreads  number of threads (default: number of processors)
+  z         z values (same size and class as R)
+----------------------------------------------------------------------------*/
+#include "mexstats.h"
+
+void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+  if ((nrhs < 1) || (nrhs > 2))
+    mexErrMsgIdAndTxt(MXS_ERRID, "fr2z requires 1 or 2 inputs.");
+  if (nlhs > 1)
+    mexErrMsgIdAndTxt(MXS_ERRID, "fr2z returns 1 output.");
+  mxs_data(prhs[0], "R");
+  size_t len = mxGetNumberOfElements(prhs[0]);
+  int ntasks = mxs_int((len + MXS_BLKSIZE-1) / MXS_BLKSIZE, "R");
+  int nthreads = mxs_nthreads(nrhs, prhs, 1);
+  mxs_init();
+
+  plhs[0] = mxCreateNumericArray(mxGetNumberOfDimensions(prhs[0]),
+                                 mxGetDimensions(prhs[0]),
+                                 mxGetClassID(prhs[0]), mxREAL);
+  if (mxIsSingle(prhs[0])) {
+    smxsjob j = { .x1 = (const float*)mxGetData(prhs[0]), .len = len,
+                  .r1 = (float*)mxGetData(plhs[0]) };
+    stats_parfor(nthreads, ntasks, sfr2ztask, &j);
+  }
+  else {
+    dmxsjob j = { .x1 = (const double*)mxGetData(prhs[0]), .len = len,
+                  .r1 = (double*)mxGetData(plhs[0]) };
+    stats_parfor(nthreads, ntasks, dfr2ztask, &j);
+  }
+}  // mexFunction()
@@ -0,0 +1,166 @@
+/*----------------------------------------------------------------------------
+  File    : mexstats.h
+  Contents: common code of the mex gateways
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef MEXSTATS_H
+#define MEXSTATS_H
+
+#include <limits.h>
+#include <string.h>
+#include "mex.h"
+#include "stats.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define MXS_BLKSIZE  4096       // number of values per task (fr2z)
+
+#define MXS_MDIFF    0          // test statistics for perm
+#define MXS_TSTAT2   1
+#define MXS_PAIREDT  2
+#define MXS_DIDT     3
+#define MXS_RANKSUM  4
+#define MXS_SIGNRANK 5
+#define MXS_ANOVA1   6
+
+#define MXS_ERRID    "stats:invalidInput"
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static inline void mxs_exit (void)
+{                               // --- clean up before the gateway
+  stats_pool_exit();            //     is unloaded
+}  // mxs_exit()
+
+/*--------------------------------------------------------------------------*/
+
+static inline void mxs_init (void)
+{                               // --- initialize the library
+  static int init = 0;
+  if (init) return;
+  stats_set_impl(STATS_AUTO);   // select the implementations before
+  mexAtExit(mxs_exit);          // any threads are started
+  init = 1;
+}  // mxs_init()
+
+/*--------------------------------------------------------------------------*/
+
+static inline void mxs_data (const mxArray *a, const char *name)
+{                               // --- check a data argument
+  if (!(mxIsSingle(a) || mxIsDouble(a)) || mxIsComplex(a) || mxIsSparse(a))
+    mexErrMsgIdAndTxt(MXS_ERRID,
+      "%s must be a real, full matrix of class single or double.", name);
+}  // mxs_data()
+
+/*--------------------------------------------------------------------------*/
+
+static inline int mxs_int (mwSize n, const char *name)
+{                               // --- check a dimension
+  if (n > INT_MAX)
+    mexErrMsgIdAndTxt(MXS_ERRID, "%s is too large.", name);
+  return (int)n;
+}  // mxs_int()
+
+/*--------------------------------------------------------------------------*/
+
+static inline int mxs_nthreads (int nrhs, const mxArray *prhs[], int k)
+{                               // --- get the (optional) number of threads
+  if (nrhs <= k) return 0;      // (0 -> number of processors)
+  if (!mxIsNumeric(prhs[k]) || (mxGetNumberOfElements(prhs[k]) != 1))
+    mexErrMsgIdAndTxt(MXS_ERRID, "nthreads must be a numeric scalar.");
+  double d = mxGetScalar(prhs[k]);
+  return (d > 0) ? ((d < INT_MAX) ? (int)d : INT_MAX) : 0;
+}  // mxs_nthreads()
+
+/*--------------------------------------------------------------------------*/
+
+static inline mxArray* mxs_out (const mxArray *a, mwSize m, mwSize n)
+{                               // --- create an output matrix
+  return mxCreateNumericMatrix(m, n, mxGetClassID(a), mxREAL);
+}  // mxs_out()                 // (same class as a)
+
+/*--------------------------------------------------------------------------*/
+
+static inline double mxs_get (const mxArray *a, mwIndex i)
+{                               // --- get an element of a numeric array
+  switch (mxGetClassID(a)) {
+    case mxDOUBLE_CLASS: return ((const double*)mxGetData(a))[i];
+    case mxSINGLE_CLASS: return ((const float*) mxGetData(a))[i];
+    case mxINT32_CLASS:  return ((const int*)   mxGetData(a))[i];
+    default:
+      mexErrMsgIdAndTxt(MXS_ERRID,
+        "Index arrays must be of class double, single or int32.");
+  }
+  return 0;
+}  // mxs_get()
+
+/*----------------------------------------------------------------------------
+  Tasks
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL         float      // (re)define REAL to be float
+#define tres         stres
+#define mxsjob       smxsjob
+#define mxsfuncs     smxsfuncs
+#define tstattask    ststattask
+#define tstat2task   ststat2task
+#define welchttask   swelchttask
+#define pairedttask  spairedttask
+#define permtask     spermtask
+#define fr2ztask     sfr2ztask
+#include "def-or-undef-functions.inc"
+#include "mexstats_real.h"      // single precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef tres
+#undef mxsjob
+#undef mxsfuncs
+#undef tstattask
+#undef tstat2task
+#undef welchttask
+#undef pairedttask
+#undef permtask
+#undef fr2ztask
+/*--------------------------------------------------------------------------*/
+#define REAL         double     // (re)define REAL to be double
+#define tres         dtres
+#define mxsjob       dmxsjob
+#define mxsfuncs     dmxsfuncs
+#define tstattask    dtstattask
+#define tstat2task   dtstat2task
+#define welchttask   dwelchttask
+#define pairedttask  dpairedttask
+#define permtask     dpermtask
+#define fr2ztask     dfr2ztask
+#include "def-or-undef-functions.inc"
+#include "mexstats_real.h"      // double precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef tres
+#undef mxsjob
+#undef mxsfuncs
+#undef tstattask
+#undef tstat2task
+#undef welchttask
+#undef pairedttask
+#undef permtask
+#undef fr2ztask
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
+
+#endif  // #ifndef MEXSTATS_H
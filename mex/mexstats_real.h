@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------
+  File    : mexstats_real.h
+  Contents: this file is to be included from mexstats.h
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- job for the thread-parallel loops
+  const REAL *x1, *x2;          // data (one data set per column)
+  int        n1, n2;            // number of rows of x1 and x2
+  REAL       *r1, *r2;          // results (one value per column)
+  int        *n;                // sizes of the samples (perm)
+  const int  *prm;              // permutations (perm)
+  int        np;                // number of permutations (perm)
+  int        fn;                // test statistic (perm, MXS_*)
+  int        pairs;             // whether prm only exchanges the members
+                                // of pairs (perm, signrank)
+  size_t     len;               // number of values (fr2z)
+  int        err;               // error indicator
+} mxsjob;
+
+/*----------------------------------------------------------------------------
+  Constants
+----------------------------------------------------------------------------*/
+static Func1 *const mxsfuncs[] = {      // statistics for perm()
+  mdiff_w, tstat2_w, pairedt_w, didt_w,    // (indexed by MXS_*)
+  ranksum_w, signrank_w, anova1_w };
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static inline void tstattask (void *data, int tid, int beg, int end)
+{                               // --- one-sample t test
+  mxsjob *j = (mxsjob*)data;
+  for (int v = beg; v < end; v++)
+    j->r1[v] = tstat(j->x1 + (size_t)v*(size_t)j->n1, j->n1);
+}  // tstattask()
+
+/*--------------------------------------------------------------------------*/
+
+static inline void tstat2task (void *data, int tid, int beg, int end)
+{                               // --- two-sample t test
+  mxsjob *j = (mxsjob*)data;
+  for (int v = beg; v < end; v++)
+    j->r1[v] = tstat2(j->x1 + (size_t)v*(size_t)j->n1,
+                      j->x2 + (size_t)v*(size_t)j->n2, j->n1, j->n2);
+}  // tstat2task()
+
+/*--------------------------------------------------------------------------*/
+
+static inline void welchttask (void *data, int tid, int beg, int end)
+{                               // --- Welch's t test
+  mxsjob *j = (mxsjob*)data;
+  for (int v = beg; v < end; v++) {
+    tres r = welcht(j->x1 + (size_t)v*(size_t)j->n1,
+                    j->x2 + (size_t)v*(size_t)j->n2, j->n1, j->n2);
+    j->r1[v] = r.t;
+    if (j->r2) j->r2[v] = r.df;
+  }
+}  // welchttask()
+
+/*--------------------------------------------------------------------------*/
+
+static inline void pairedttask (void *data, int tid, int beg, int end)
+{                               // --- paired t test
+  mxsjob *j = (mxsjob*)data;
+  for (int v = beg; v < end; v++)
+    j->r1[v] = pairedt(j->x1 + (size_t)v*(size_t)j->n1,
+                       j->x2 + (size_t)v*(size_t)j->n1, j->n1);
+}  // pairedttask()
+
+/*--------------------------------------------------------------------------*/
+
+static inline void permtask (void *data, int tid, int beg, int end)
+{                               // --- permutation test
+  mxsjob *j = (mxsjob*)data;
+  int  ntotal = j->n1;
+  REAL *tmp   = (REAL*) malloc((size_t)(3*ntotal) *sizeof(REAL));
+  if (!tmp) { j->err = -1; return; }
+
+  for (int v = beg; v < end; v++) {
+    const REAL *a = j->x1 + (size_t)v*(size_t)ntotal;
+    REAL *s = j->r2 ? j->r2 + v : NULL;
+    switch (j->fn) {
+      case MXS_RANKSUM:
+        j->r1[v] = rankperm  (a, j->n, ntotal, j->prm, j->np, tmp, s);
+        break;
+      case MXS_SIGNRANK:             // (signperm() requires pair swaps)
+        j->r1[v] = j->pairs
+                 ? signperm(a, j->n, ntotal, j->prm, j->np, tmp, s)
+                 : perm(a, j->n, ntotal, j->prm, j->np, signrank_w, tmp, s);
+        break;
+      case MXS_ANOVA1:
+        j->r1[v] = anova1perm(a, j->n, ntotal, j->prm, j->np, tmp, s);
+        break;
+      default:
+        j->r1[v] = perm(a, j->n, ntotal, j->prm, j->np,
+                        mxsfuncs[j->fn], tmp, s);
+        break;
+    }
+  }
+  free(tmp);
+}  // permtask()
+
+/*--------------------------------------------------------------------------*/
+
+static inline void fr2ztask (void *data, int tid, int beg, int end)
+{                               // --- Fisher's r-to-z transformation
+  mxsjob *j = (mxsjob*)data;
+  size_t i = (size_t)beg * MXS_BLKSIZE;
+  size_t e = (size_t)end * MXS_BLKSIZE;
+  if (e > j->len) e = j->len;
+  for ( ; i < e; i++)
+    j->r1[i] = fr2z(j->x1[i]);
+}  // fr2ztask()
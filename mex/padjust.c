@@ -0,0 +1,48 @@
+/*----------------------------------------------------------------------------
+  File    : padjust.c
+  Contents: mex gateway for the adjustment of p values
+  Author  : Kristian Loewe
+
+  Usage   : q = padjust(p [, method [, nthreads]])
+
+  p         p values (any size, single or double; NaNs are ignored)
+  method    'BH' (Benjamini-Hochberg, default), 'BY' (Benjamini-
+            Yekutieli) or 'holm'
+  nthreads  number of threads (default: number of processors)
+  q         adjusted p values (same size and class as p)
+----------------------------------------------------------------------------*/
+#include "mexstats.h"
+#include "stats_mcp.h"
+
+void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+  static const char *names[] = { "BH", "BY", "holm" };
+  static const int   codes[] = { MCP_BH, MCP_BY, MCP_HOLM };
+
+  if ((nrhs < 1) || (nrhs > 3))
+    mexErrMsgIdAndTxt(MXS_ERRID, "padjust requires 1 to 3 inputs.");
+  if (nlhs > 1)
+    mexErrMsgIdAndTxt(MXS_ERRID, "padjust returns 1 output.");
+  mxs_data(prhs[0], "p");
+  int n = mxs_int(mxGetNumberOfElements(prhs[0]), "p");
+
+  // get the method
+  char name[8];
+  int  method = (nrhs > 1) ? -1 : MCP_BH;
+  if ((nrhs > 1) && mxIsChar(prhs[1])
+  &&  (mxGetString(prhs[1], name, sizeof(name)) == 0))
+    for (int i = 0; i < (int)(sizeof(names)/sizeof(*names)); i++)
+      if (strcmp(name, names[i]) == 0) method = codes[i];
+  if (method < 0)
+    mexErrMsgIdAndTxt(MXS_ERRID, "Unknown method.");
+  int nthreads = mxs_nthreads(nrhs, prhs, 2);
+  mxs_init();
+
+  plhs[0] = mxDuplicateArray(prhs[0]);
+  if (n == 0) return;
+  int r = mxIsSingle(prhs[0])
+        ? spadjust((float*) mxGetData(plhs[0]), n, method, nthreads)
+        : dpadjust((double*)mxGetData(plhs[0]), n, method, nthreads);
+  if (r != 0)
+    mexErrMsgIdAndTxt("stats:outOfMemory", "Out of memory.");
+}  // mexFunction()
@@ -0,0 +1,47 @@
+/*----------------------------------------------------------------------------
+  File    : pairedt.c
+  Contents: mex gateway for the paired t test
+  Author  : Kristian Loewe
+
+  Usage   : t = pairedt(X1, X2 [, nthreads])
+
+  X1, X2    paired data (n x m each, single or double, same class),
+            one data set per column
+  nthreads  number of threads (default: number of processors)
+  t         t statistics (1 x m, same class as X1)
+----------------------------------------------------------------------------*/
+#include "mexstats.h"
+
+void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+  if ((nrhs < 2) || (nrhs > 3))
+    mexErrMsgIdAndTxt(MXS_ERRID, "pairedt requires 2 or 3 inputs.");
+  if (nlhs > 1)
+    mexErrMsgIdAndTxt(MXS_ERRID, "pairedt returns 1 output.");
+  mxs_data(prhs[0], "X1");
+  mxs_data(prhs[1], "X2");
+  if (mxGetClassID(prhs[0]) != mxGetClassID(prhs[1]))
+    mexErrMsgIdAndTxt(MXS_ERRID, "X1 and X2 must be of the same class.");
+  int n = mxs_int(mxGetM(prhs[0]), "size(X1,1)");
+  int m = mxs_int(mxGetN(prhs[0]), "size(X1,2)");
+  if (((mwSize)n != mxGetM(prhs[1])) || ((mwSize)m != mxGetN(prhs[1])))
+    mexErrMsgIdAndTxt(MXS_ERRID, "X1 and X2 must have the same size.");
+  if (n < 2)
+    mexErrMsgIdAndTxt(MXS_ERRID, "X1 and X2 must have at least 2 rows.");
+  int nthreads = mxs_nthreads(nrhs, prhs, 2);
+  mxs_init();
+
+  plhs[0] = mxs_out(prhs[0], 1, (mwSize)m);
+  if (mxIsSingle(prhs[0])) {
+    smxsjob j = { .x1 = (const float*)mxGetData(prhs[0]),
+                  .x2 = (const float*)mxGetData(prhs[1]),
+                  .n1 = n, .r1 = (float*)mxGetData(plhs[0]) };
+    stats_parfor(nthreads, m, spairedttask, &j);
+  }
+  else {
+    dmxsjob j = { .x1 = (const double*)mxGetData(prhs[0]),
+                  .x2 = (const double*)mxGetData(prhs[1]),
+                  .n1 = n, .r1 = (double*)mxGetData(plhs[0]) };
+    stats_parfor(nthreads, m, dpairedttask, &j);
+  }
+}  // mexFunction()
@@ -0,0 +1,125 @@
+/*----------------------------------------------------------------------------
+  File    : perm.c
+  Contents: mex gateway for the permutation tests
+  Author  : Kristian Loewe
+
+  Usage   : [p, s] = perm(X, n, prm, func [, nthreads])
+
+  X         data (ntotal x m, single or double), one data set per column,
+            laid out as for the corresponding *_w function
+  n         sizes of the samples
+            'mdiff', 'tstat2', 'ranksum': [n1 n2],     ntotal = n1+n2
+            'pairedt', 'signrank':        n1,          ntotal = 2*n1
+            'didt':                       [nx ny],     ntotal = 2*(nx+ny)
+            'anova1':                     [n1 ... nk], ntotal = sum(n)
+  prm       permutations (ntotal x np, double, single or int32),
+            one permutation per column, 1-based indices into the rows of X
+            (for 'signrank', permutations that only exchange the members
+            of pairs, i.e., prm(j) is j or n1+j and prm(n1+j) is the
+            other one, are evaluated faster)
+  func      test statistic (see n)
+  nthreads  number of threads (default: number of processors)
+  p         p values (1 x m, same class as X)
+  s         statistics (1 x m, same class as X)
+----------------------------------------------------------------------------*/
+#include "mexstats.h"
+
+/*----------------------------------------------------------------------------
+  Constants
+----------------------------------------------------------------------------*/
+static const char *names[] = {  // names of the test statistics
+  "mdiff", "tstat2", "pairedt", "didt", "ranksum", "signrank", "anova1" };
+static const int  nsmp[]   = {  // number of samples (0: any number > 1)
+   2,       2,        1,         2,      2,         1,          0 };
+
+/*--------------------------------------------------------------------------*/
+
+void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+  if ((nrhs < 4) || (nrhs > 5))
+    mexErrMsgIdAndTxt(MXS_ERRID, "perm requires 4 or 5 inputs.");
+  if (nlhs > 2)
+    mexErrMsgIdAndTxt(MXS_ERRID, "perm returns 2 outputs.");
+  mxs_data(prhs[0], "X");
+  int ntotal = mxs_int(mxGetM(prhs[0]), "size(X,1)");
+  int m      = mxs_int(mxGetN(prhs[0]), "size(X,2)");
+
+  // get the test statistic
+  char name[16];
+  int  fn = -1;
+  if (mxIsChar(prhs[3]) && (mxGetString(prhs[3], name, sizeof(name)) == 0))
+    for (int i = 0; i < (int)(sizeof(names)/sizeof(*names)); i++)
+      if (strcmp(name, names[i]) == 0) fn = i;
+  if (fn < 0)
+    mexErrMsgIdAndTxt(MXS_ERRID, "Unknown test statistic.");
+
+  // get the sample sizes (terminated by 0)
+  int k = mxs_int(mxGetNumberOfElements(prhs[1]), "n");
+  if ((nsmp[fn] > 0) ? (k != nsmp[fn]) : (k < 2))
+    mexErrMsgIdAndTxt(MXS_ERRID, "Wrong number of sample sizes.");
+  int *n = (int*) mxMalloc((size_t)(k+1) *sizeof(int));
+  long long sum = 0;
+  for (int i = 0; i < k; i++) {
+    double d = mxs_get(prhs[1], (mwIndex)i);
+    if (!(d >= 2) || (d > INT_MAX))
+      mexErrMsgIdAndTxt(MXS_ERRID, "Sample sizes must be at least 2.");
+    sum += n[i] = (int)d;
+  }
+  n[k] = 0;
+  if      ((fn == MXS_PAIREDT) || (fn == MXS_SIGNRANK)) sum *= 2;
+  else if  (fn == MXS_DIDT)                             sum *= 2;
+  if (sum != ntotal)
+    mexErrMsgIdAndTxt(MXS_ERRID, "Sample sizes do not match size(X,1).");
+
+  // convert the permutations to 0-based indices
+  if ((mxGetM(prhs[2]) != (mwSize)ntotal) || mxIsComplex(prhs[2]))
+    mexErrMsgIdAndTxt(MXS_ERRID, "prm must have size(X,1) rows.");
+  int np = mxs_int(mxGetN(prhs[2]), "size(prm,2)");
+  if (np < 1)
+    mexErrMsgIdAndTxt(MXS_ERRID, "prm must have at least 1 column.");
+  size_t nprm = (size_t)ntotal*(size_t)np;
+  int *prm = (int*) mxMalloc(nprm *sizeof(int));
+  for (size_t i = 0; i < nprm; i++) {
+    double d = mxs_get(prhs[2], (mwIndex)i);
+    if (!(d >= 1) || (d > ntotal))
+      mexErrMsgIdAndTxt(MXS_ERRID, "prm contains invalid indices.");
+    prm[i] = (int)d - 1;
+  }
+
+  // check whether the permutations only exchange the members of pairs
+  int pairs = (fn == MXS_SIGNRANK);
+  int h     = ntotal/2;
+  for (size_t i = 0; pairs && (i < (size_t)np); i++) {
+    const int *pi = prm + i*(size_t)ntotal;
+    for (int r = 0; r < h; r++)
+      if (!(((pi[r] == r)   && (pi[h+r] == h+r))
+      ||    ((pi[r] == h+r) && (pi[h+r] == r)))) {
+        pairs = 0; break; }
+  }
+  int nthreads = mxs_nthreads(nrhs, prhs, 4);
+  mxs_init();
+
+  plhs[0] = mxs_out(prhs[0], 1, (mwSize)m);
+  if (nlhs > 1)
+    plhs[1] = mxs_out(prhs[0], 1, (mwSize)m);
+  void *s = (nlhs > 1) ? mxGetData(plhs[1]) : NULL;
+  int err;
+  if (mxIsSingle(prhs[0])) {
+    smxsjob j = { .x1 = (const float*)mxGetData(prhs[0]), .n1 = ntotal,
+                  .n = n, .prm = prm, .np = np, .fn = fn, .pairs = pairs,
+                  .r1 = (float*)mxGetData(plhs[0]), .r2 = (float*)s };
+    stats_parfor(nthreads, m, spermtask, &j);
+    err = j.err;
+  }
+  else {
+    dmxsjob j = { .x1 = (const double*)mxGetData(prhs[0]), .n1 = ntotal,
+                  .n = n, .prm = prm, .np = np, .fn = fn, .pairs = pairs,
+                  .r1 = (double*)mxGetData(plhs[0]), .r2 = (double*)s };
+    stats_parfor(nthreads, m, dpermtask, &j);
+    err = j.err;
+  }
+  mxFree(prm);
+  mxFree(n);
+  if (err)
+    mexErrMsgIdAndTxt("stats:outOfMemory", "Out of memory.");
+}  // mexFunction()
@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------
+  File    : tstat.c
+  Contents: mex gateway for the one-sample t test
+  Author  : Kristian Loewe
+
+  Usage   : t = tstat(X [, nthreads])
+
+  X         data (n x m, single or double), one data set per column
+  nthreads  number of threads (default: number of processors)
+  t         t statistics (1 x m, same class as X)
+----------------------------------------------------------------------------*/
+#include "mexstats.h"
+
+void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+  if ((nrhs < 1) || (nrhs > 2))
+    mexErrMsgIdAndTxt(MXS_ERRID, "tstat requires 1 or 2 inputs.");
+  if (nlhs > 1)
+    mexErrMsgIdAndTxt(MXS_ERRID, "tstat returns 1 output.");
+  mxs_data(prhs[0], "X");
+  int n = mxs_int(mxGetM(prhs[0]), "size(X,1)");
+  int m = mxs_int(mxGetN(prhs[0]), "size(X,2)");
+  if (n < 2)
+    mexErrMsgIdAndTxt(MXS_ERRID, "X must have at least 2 rows.");
+  int nthreads = mxs_nthreads(nrhs, prhs, 1);
+  mxs_init();
+
+  plhs[0] = mxs_out(prhs[0], 1, (mwSize)m);
+  if (mxIsSingle(prhs[0])) {
+    smxsjob j = { .x1 = (const float*)mxGetData(prhs[0]), .n1 = n,
+                  .r1 = (float*)mxGetData(plhs[0]) };
+    stats_parfor(nthreads, m, ststattask, &j);
+  }
+  else {
+    dmxsjob j = { .x1 = (const double*)mxGetData(prhs[0]), .n1 = n,
+                  .r1 = (double*)mxGetData(plhs[0]) };
+    stats_parfor(nthreads, m, dtstattask, &j);
+  }
+}  // mexFunction()
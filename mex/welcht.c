@@ -0,0 +1,54 @@
+/*----------------------------------------------------------------------------
+  File    : welcht.c
+  Contents: mex gateway for Welch's t test
+  Author  : Kristian Loewe
+
+  Usage   : [t, df] = welcht(X1, X2 [, nthreads])
+
+  X1, X2    data (n1 x m and n2 x m, single or double, same class),
+            one data set per column
+  nthreads  number of threads (default: number of processors)
+  t         t statistics (1 x m, same class as X1)
+  df        degrees of freedom (1 x m, same class as X1)
+----------------------------------------------------------------------------*/
+#include "mexstats.h"
+
+void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+  if ((nrhs < 2) || (nrhs > 3))
+    mexErrMsgIdAndTxt(MXS_ERRID, "welcht requires 2 or 3 inputs.");
+  if (nlhs > 2)
+    mexErrMsgIdAndTxt(MXS_ERRID, "welcht returns 2 outputs.");
+  mxs_data(prhs[0], "X1");
+  mxs_data(prhs[1], "X2");
+  if (mxGetClassID(prhs[0]) != mxGetClassID(prhs[1]))
+    mexErrMsgIdAndTxt(MXS_ERRID, "X1 and X2 must be of the same class.");
+  int n1 = mxs_int(mxGetM(prhs[0]), "size(X1,1)");
+  int n2 = mxs_int(mxGetM(prhs[1]), "size(X2,1)");
+  int m  = mxs_int(mxGetN(prhs[0]), "size(X1,2)");
+  if ((mwSize)m != mxGetN(prhs[1]))
+    mexErrMsgIdAndTxt(MXS_ERRID, "X1 and X2 must have the same columns.");
+  if ((n1 < 2) || (n2 < 2))
+    mexErrMsgIdAndTxt(MXS_ERRID, "X1 and X2 must have at least 2 rows.");
+  int nthreads = mxs_nthreads(nrhs, prhs, 2);
+  mxs_init();
+
+  plhs[0] = mxs_out(prhs[0], 1, (mwSize)m);
+  if (nlhs > 1)
+    plhs[1] = mxs_out(prhs[0], 1, (mwSize)m);
+  void *df = (nlhs > 1) ? mxGetData(plhs[1]) : NULL;
+  if (mxIsSingle(prhs[0])) {
+    smxsjob j = { .x1 = (const float*)mxGetData(prhs[0]),
+                  .x2 = (const float*)mxGetData(prhs[1]),
+                  .n1 = n1, .n2 = n2, .r1 = (float*)mxGetData(plhs[0]),
+                  .r2 = (float*)df };
+    stats_parfor(nthreads, m, swelchttask, &j);
+  }
+  else {
+    dmxsjob j = { .x1 = (const double*)mxGetData(prhs[0]),
+                  .x2 = (const double*)mxGetData(prhs[1]),
+                  .n1 = n1, .n2 = n2, .r1 = (double*)mxGetData(plhs[0]),
+                  .r2 = (double*)df };
+    stats_parfor(nthreads, m, dwelchttask, &j);
+  }
+}  // mexFunction()
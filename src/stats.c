@@ -18,43 +18,59 @@
 /*--------------------------------------------------------------------------*/
 #define REAL        float       // (re)define REAL to be float
 #define tres        stres
+#define grp         sgrp
 #define sum_func    ssum_func
 #define varm_func   svarm_func
 #define sum_ptr     ssum_ptr
 #define varm_ptr    svarm_ptr
 #define sum_select  ssum_select
 #define varm_select svarm_select
+#define pivcnt_func   spivcnt_func
+#define pivcnt_ptr    spivcnt_ptr
+#define pivcnt_select spivcnt_select
 #include "def-or-undef-functions.inc"
 #include "stats_real.c"         // single precision versions
 #undef REAL
 #include "def-or-undef-functions.inc"
 #undef tres
+#undef grp
 #undef sum_func
 #undef varm_func
 #undef sum_ptr
 #undef varm_ptr
 #undef sum_select
 #undef varm_select
+#undef pivcnt_func
+#undef pivcnt_ptr
+#undef pivcnt_select
 /*--------------------------------------------------------------------------*/
 #define REAL        double      // (re)define REAL to be double
 #define tres        dtres
+#define grp         dgrp
 #define sum_func    dsum_func
 #define varm_func   dvarm_func
 #define sum_ptr     dsum_ptr
 #define varm_ptr    dvarm_ptr
 #define sum_select  dsum_select
 #define varm_select dvarm_select
+#define pivcnt_func   dpivcnt_func
+#define pivcnt_ptr    dpivcnt_ptr
+#define pivcnt_select dpivcnt_select
 #include "def-or-undef-functions.inc"
 #include "stats_real.c"         // double precision versions
 #undef REAL
 #include "def-or-undef-functions.inc"
 #undef tres
+#undef grp
 #undef sum_func
 #undef varm_func
 #undef sum_ptr
 #undef varm_ptr
 #undef sum_select
 #undef varm_select
+#undef pivcnt_func
+#undef pivcnt_ptr
+#undef pivcnt_select
 /*--------------------------------------------------------------------------*/
 #undef REAL                     // restore original definition of REAL
 #ifdef REAL_IS_DOUBLE           // (if necessary)
@@ -93,13 +109,19 @@ double dssum_select (const float *a, int n)
 
 stats_flags stats_set_impl (stats_flags impl) {
 
-  #ifndef ARCH_IS_X86_64
-  impl = STATS_NAIVE;
+  #ifdef ARCH_IS_X86_64
+  if (impl == STATS_VEC)        // (dot has no generic vector
+    dot_set_impl(STATS_AUTO);   //  implementations)
+  else
+    dot_set_impl(impl);
+  #else
+  if (impl != STATS_NAIVE)      // without x86 intrinsics, use the
+    impl = STATS_VEC;           // generic vectors (if available)
+  dot_set_impl(STATS_NAIVE);
   #endif
 
-  dot_set_impl(impl);
-  
   switch (impl) {
+    #ifdef ARCH_IS_X86_64
     case STATS_AUTO :
     case STATS_AVX :
       if (hasAVX()) {
@@ -116,20 +138,40 @@ stats_flags stats_set_impl (stats_flags impl) {
         ssum_ptr     = &ssum_sse2;
         svarm_ptr    = &svarm_sse2;
 
+        spivcnt_ptr  = &spivcnt_sse2;
+
         dsum_ptr     = &dsum_naive;     // TODO
         dvarm_ptr    = &dvarm_naive;    // TODO
+        dpivcnt_ptr  = &dpivcnt_sse2;
 
         dssum_ptr    = &dssum_naive;    // TODO
         // ... TODO
 
         return STATS_SSE2;
       }
+    #endif
+    case STATS_VEC :
+      #ifdef STATS_HAS_VEC
+      ssum_ptr     = &ssum_vec;
+      svarm_ptr    = &svarm_vec;
+      spivcnt_ptr  = &spivcnt_vec;
+
+      dsum_ptr     = &dsum_vec;
+      dvarm_ptr    = &dvarm_vec;
+      dpivcnt_ptr  = &dpivcnt_vec;
+
+      dssum_ptr    = &dssum_vec;
+
+      return STATS_VEC;
+      #endif
     case STATS_NAIVE :
       ssum_ptr     = &ssum_naive;
       svarm_ptr    = &svarm_naive;
+      spivcnt_ptr  = &spivcnt_naive;
 
       dsum_ptr     = &dsum_naive;
       dvarm_ptr    = &dvarm_naive;
+      dpivcnt_ptr  = &dpivcnt_naive;
 
       dssum_ptr    = &dssum_naive;
       // ... TODO
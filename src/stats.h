@@ -24,8 +24,18 @@ extern "C"
 #define ARCH_IS_X86_64
 #endif
 
+#if defined(__GNUC__) || defined(__clang__)
+#define STATS_HAS_VEC           // generic vectors (vector_size attribute)
+#endif
+
 #define R2Z_MAX 18.3684002848385504   // atanh(1-epsilon)
 
+#define RANKS_DIRECT 256        // max. n for ranking by direct comparison
+
+#define PERMV_LANES  8          // permutations per block (see permv())
+#define PERMV_MAXN   256        // max. ntotal for blockwise evaluation
+#define SEQPERM_LOGD 6.90775527898213705   // log(1/delta), delta = 0.001
+
 /*----------------------------------------------------------------------------
   Type Definitions: enum to encode the sets of implementations
 ----------------------------------------------------------------------------*/
@@ -36,6 +46,7 @@ typedef enum {
     STATS_AVXFMA    = 4,   // AVX+FMA3
     STATS_AVX512    = 5,   // AVX512
     STATS_AVX512FMA = 6,   // AVX512+FMA3
+    STATS_VEC       = 10,  // generic vectors (GCC/Clang extensions)
     STATS_AUTO      = 100  // automatic choice
 } stats_flags;
 // Using stats_set_impl(), these values are used to specify the set of
@@ -43,16 +54,22 @@ typedef enum {
 // wrt the advent of the prerequisite instruction set extensions, with
 // STATS_NAIVE representing the plain C fallback implementations, and
 // STATS_AUTO indicating that the best set of implementations should be
-// chosen automatically.
+// chosen automatically. STATS_VEC is not tied to an instruction set; it
+// selects portable implementations based on the vector extensions of
+// GCC and Clang, which are the automatic choice on other architectures.
 
 /*----------------------------------------------------------------------------
   Type Definitions: functions
 ----------------------------------------------------------------------------*/
 typedef float  (ssum_func)     (const float  *a, int n);
 typedef float  (svarm_func)    (const float  *a, int n, float  m);
+typedef void   (spivcnt_func)  (const float  *a, int n, float  p,
+                                int *lt, int *eq);
 
 typedef double (dsum_func)     (const double *a, int n);
 typedef double (dvarm_func)    (const double *a, int n, double m);
+typedef void   (dpivcnt_func)  (const double *a, int n, double p,
+                                int *lt, int *eq);
 
 typedef double (dssum_func)    (const float  *a, int n);
 // ... TODO
@@ -62,9 +79,11 @@ typedef double (dssum_func)    (const float  *a, int n);
 ----------------------------------------------------------------------------*/
 extern ssum_func  *ssum_ptr;
 extern svarm_func *svarm_ptr;
+extern spivcnt_func *spivcnt_ptr;
 
 extern dsum_func  *dsum_ptr;
 extern dvarm_func *dvarm_ptr;
+extern dpivcnt_func *dpivcnt_ptr;
 
 extern dssum_func *dssum_ptr;
 // ... TODO
@@ -82,6 +101,18 @@ typedef struct dtres {
   double df;
 } dtres;
 
+typedef struct sgrp {           // --- prepared group (see grpinit())
+  int   n;                      // number of values
+  float m;                      // mean
+  float m2;                     // sum of squared deviations from the mean
+} sgrp;
+
+typedef struct dgrp {
+  int    n;
+  double m;
+  double m2;
+} dgrp;
+
 /*----------------------------------------------------------------------------
   Function Prototypes
 ----------------------------------------------------------------------------*/
@@ -104,6 +135,7 @@ inline double dssum    (const float  *a, int n);
  *       STATS_AVXFMA    -> AVX+FMA3 implementations
  *       STATS_AVX512    -> AVX512 implementations
  *       STATS_AVX512FMA -> AVX512+FMA3 implementations
+ *       STATS_VEC       -> generic vector implementations
  *       STATS_AUTO      -> automatically choose the best available set
  *       (see also the above enum)
  *
@@ -115,18 +147,26 @@ extern stats_flags stats_set_impl (stats_flags impl);
 
 extern float  ssum_select  (const float  *a, int n);
 extern float  svarm_select (const float  *a, int n, float m);
+extern void   spivcnt_select (const float  *a, int n, float  p,
+                              int *lt, int *eq);
 
 extern double dsum_select  (const double *a, int n);
 extern double dvarm_select (const double *a, int n, double m);
+extern void   dpivcnt_select (const double *a, int n, double p,
+                              int *lt, int *eq);
 
 extern double dssum_select (const float  *a, int n);
 // ... TODO
 
 extern float  ssum_naive   (const float  *a, int n);
 extern float  svarm_naive  (const float  *a, int n, float m);
+extern void   spivcnt_naive (const float  *a, int n, float  p,
+                             int *lt, int *eq);
 
 extern double dsum_naive   (const double *a, int n);
 extern double dvarm_naive  (const double *a, int n, double m);
+extern void   dpivcnt_naive (const double *a, int n, double p,
+                             int *lt, int *eq);
 
 extern double dssum_naive  (const float  *a, int n);
 // ... TODO
@@ -134,14 +174,32 @@ extern double dssum_naive  (const float  *a, int n);
 #ifdef ARCH_IS_X86_64
 extern float  ssum_sse2    (const float  *a, int n);
 extern float  svarm_sse2   (const float  *a, int n, float m);
+extern void   spivcnt_sse2  (const float  *a, int n, float  p,
+                             int *lt, int *eq);
 
 extern double dsum_sse2    (const double *a, int n);
 extern double dvarm_sse2   (const double *a, int n, double m);
+extern void   dpivcnt_sse2  (const double *a, int n, double p,
+                             int *lt, int *eq);
 
 // extern double dssum_sse2    (const float  *a, int n);
 // ... TODO
 #endif
 
+#ifdef STATS_HAS_VEC
+extern float  ssum_vec     (const float  *a, int n);
+extern float  svarm_vec    (const float  *a, int n, float m);
+extern void   spivcnt_vec   (const float  *a, int n, float  p,
+                             int *lt, int *eq);
+
+extern double dsum_vec     (const double *a, int n);
+extern double dvarm_vec    (const double *a, int n, double m);
+extern void   dpivcnt_vec   (const double *a, int n, double p,
+                             int *lt, int *eq);
+
+extern double dssum_vec    (const float  *a, int n);
+#endif
+
 /*----------------------------------------------------------------------------
   Inline Functions
 ----------------------------------------------------------------------------*/
@@ -154,8 +212,10 @@ extern double dvarm_sse2   (const double *a, int n, double m);
 #define sqrt      sqrtf
 #define dot       sdot
 #define tres      stres
+#define grp       sgrp
 #define sum_ptr   ssum_ptr
 #define varm_ptr  svarm_ptr
+#define pivcnt_ptr spivcnt_ptr
 #include "def-or-undef-functions.inc"
 #include "stats_real.h"         // single precision versions
 #undef REAL
@@ -163,24 +223,30 @@ extern double dvarm_sse2   (const double *a, int n, double m);
 #undef sqrt
 #undef dot
 #undef tres
+#undef grp
 #undef sum_ptr
 #undef varm_ptr
+#undef pivcnt_ptr
 /*--------------------------------------------------------------------------*/
 #undef STATS_REAL_H             // undef guard to include header a 2nd time
 /*--------------------------------------------------------------------------*/
 #define REAL      double        // (re)define REAL to be double
 #define dot       ddot
 #define tres      dtres
+#define grp       dgrp
 #define sum_ptr   dsum_ptr
 #define varm_ptr  dvarm_ptr
+#define pivcnt_ptr dpivcnt_ptr
 #include "def-or-undef-functions.inc"
 #include "stats_real.h"         // double precision versions
 #undef REAL
 #include "def-or-undef-functions.inc"
 #undef dot
 #undef tres
+#undef grp
 #undef sum_ptr
 #undef varm_ptr
+#undef pivcnt_ptr
 /*--------------------------------------------------------------------------*/
 #ifdef REAL_IS_DOUBLE           // restore original definition of REAL
 #  if REAL_IS_DOUBLE            // (if necessary)
@@ -205,11 +271,35 @@ extern double dvarm_sse2   (const double *a, int n, double m);
 #    define mdiff     dmdiff
 #    define tstat2    dtstat2
 #    define welcht    dwelcht
+#    define grpinit   dgrpinit
+#    define tstat2p   dtstat2p
+#    define tstat2r   dtstat2r
+#    define tstat2b   dtstat2b
+#    define welchtp   dwelchtp
+#    define welchtr   dwelchtr
+#    define welchtb   dwelchtb
 #    define pairedt   dpairedt
 #    define pairedtx  dpairedtx
 #    define didt      ddidt
+#    define ranks     dranks
+#    define ranksum   dranksum
+#    define signrank  dsignrank
+#    define qselect   dqselect
+#    define quantile  dquantile
+#    define median    dmedian
+#    define mad       dmad
+#    define trmeanvar dtrmeanvar
+#    define trmean    dtrmean
+#    define winvar    dwinvar
+#    define yuent     dyuent
+#    define anova1    danova1
 
 #    define perm      dperm
+#    define permv     dpermv
+#    define seqperm   dseqperm
+#    define rankperm  drankperm
+#    define signperm  dsignperm
+#    define anova1perm danova1perm
 
 #    define sum_w     dsum_w
 #    define mean_w    dmean_w
@@ -223,6 +313,9 @@ extern double dvarm_sse2   (const double *a, int n, double m);
 #    define welcht_w  dwelcht_w
 #    define pairedt_w dpairedt_w
 #    define didt_w    ddidt_w
+#    define ranksum_w dranksum_w
+#    define signrank_w dsignrank_w
+#    define anova1_w   danova1_w
 
 #    define fr2z      dfr2z
 
@@ -240,11 +333,35 @@ extern double dvarm_sse2   (const double *a, int n, double m);
 #    define mdiff     smdiff
 #    define tstat2    ststat2
 #    define welcht    swelcht
+#    define grpinit   sgrpinit
+#    define tstat2p   ststat2p
+#    define tstat2r   ststat2r
+#    define tstat2b   ststat2b
+#    define welchtp   swelchtp
+#    define welchtr   swelchtr
+#    define welchtb   swelchtb
 #    define pairedt   spairedt
 #    define pairedtx  spairedtx
 #    define didt      sdidt
+#    define ranks     sranks
+#    define ranksum   sranksum
+#    define signrank  ssignrank
+#    define qselect   sqselect
+#    define quantile  squantile
+#    define median    smedian
+#    define mad       smad
+#    define trmeanvar strmeanvar
+#    define trmean    strmean
+#    define winvar    swinvar
+#    define yuent     syuent
+#    define anova1    sanova1
 
 #    define perm      sperm
+#    define permv     spermv
+#    define seqperm   sseqperm
+#    define rankperm  srankperm
+#    define signperm  ssignperm
+#    define anova1perm sanova1perm
 
 #    define sum_w     ssum_w
 #    define mean_w    smean_w
@@ -258,6 +375,9 @@ extern double dvarm_sse2   (const double *a, int n, double m);
 #    define welcht_w  swelcht_w
 #    define pairedt_w spairedt_w
 #    define didt_w    sdidt_w
+#    define ranksum_w sranksum_w
+#    define signrank_w ssignrank_w
+#    define anova1_w   sanova1_w
 
 #    define fr2z      sfr2z
 #  endif
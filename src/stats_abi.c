@@ -0,0 +1,199 @@
+/*----------------------------------------------------------------------------
+  File    : stats_abi.c
+  Contents: stable C ABI of the shared library (batch functions)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <math.h>
+#include "stats.h"
+#include "stats_abi.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define COL_MEAN  0             // one-sample statistics (see bcol())
+#define COL_VAR   1
+#define COL_STD   2
+#define COL_T     3
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define colstat   scolstat
+#define bcol      sbcol
+#define bcol2     sbcol2
+#define bpair     sbpair
+#include "def-or-undef-functions.inc"
+#include "stats_abi_real.c"     // single precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef colstat
+#undef bcol
+#undef bcol2
+#undef bpair
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define colstat   dcolstat
+#define bcol      dbcol
+#define bcol2     dbcol2
+#define bpair     dbpair
+#include "def-or-undef-functions.inc"
+#include "stats_abi_real.c"     // double precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef colstat
+#undef bcol
+#undef bcol2
+#undef bpair
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
+
+/*--------------------------------------------------------------------------*/
+
+static int col (int dtype, const void *X, int n, int m,
+                ptrdiff_t sn, ptrdiff_t sm, int what,
+                void *out, ptrdiff_t so)
+{                               // --- check the arguments and dispatch
+  if (!X || !out || (m < 0) || (n < ((what == COL_MEAN) ? 1 : 2)))
+    return -1;
+  switch (dtype) {
+    case STATS_F32:
+      sbcol((const float*) X, n, m, sn, sm, what, (float*) out, so);
+      return 0;
+    case STATS_F64:
+      dbcol((const double*)X, n, m, sn, sm, what, (double*)out, so);
+      return 0;
+    default:
+      return -1;
+  }
+}  // col()
+
+/*--------------------------------------------------------------------------*/
+
+static int col2 (int dtype, int m,
+                 const void *X1, int n1, ptrdiff_t sn1, ptrdiff_t sm1,
+                 const void *X2, int n2, ptrdiff_t sn2, ptrdiff_t sm2,
+                 int welch, void *out, ptrdiff_t so, void *df, ptrdiff_t sd)
+{                               // --- check the arguments and dispatch
+  if (!X1 || !X2 || !out || (m < 0) || (n1 < 2) || (n2 < 2))
+    return -1;
+  switch (dtype) {
+    case STATS_F32:
+      sbcol2(m, (const float*) X1, n1, sn1, sm1,
+                (const float*) X2, n2, sn2, sm2, welch,
+                (float*) out, so, (float*) df, sd);
+      return 0;
+    case STATS_F64:
+      dbcol2(m, (const double*)X1, n1, sn1, sm1,
+                (const double*)X2, n2, sn2, sm2, welch,
+                (double*)out, so, (double*)df, sd);
+      return 0;
+    default:
+      return -1;
+  }
+}  // col2()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+int stats_abi_version (void)
+{
+  return STATS_ABI_MAJOR * 1000 + STATS_ABI_MINOR;
+}  // stats_abi_version()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_abi_init (int impl)
+{
+  return (int)stats_set_impl((stats_flags)impl);
+}  // stats_abi_init()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_bmean (int dtype, const void *X, int n, int m,
+                 ptrdiff_t sn, ptrdiff_t sm, void *out, ptrdiff_t so)
+{
+  return col(dtype, X, n, m, sn, sm, COL_MEAN, out, so);
+}  // stats_bmean()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_bvar (int dtype, const void *X, int n, int m,
+                ptrdiff_t sn, ptrdiff_t sm, void *out, ptrdiff_t so)
+{
+  return col(dtype, X, n, m, sn, sm, COL_VAR, out, so);
+}  // stats_bvar()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_bstd (int dtype, const void *X, int n, int m,
+                ptrdiff_t sn, ptrdiff_t sm, void *out, ptrdiff_t so)
+{
+  return col(dtype, X, n, m, sn, sm, COL_STD, out, so);
+}  // stats_bstd()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_btstat (int dtype, const void *X, int n, int m,
+                  ptrdiff_t sn, ptrdiff_t sm, void *out, ptrdiff_t so)
+{
+  return col(dtype, X, n, m, sn, sm, COL_T, out, so);
+}  // stats_btstat()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_btstat2 (int dtype, int m,
+                   const void *X1, int n1, ptrdiff_t sn1, ptrdiff_t sm1,
+                   const void *X2, int n2, ptrdiff_t sn2, ptrdiff_t sm2,
+                   void *out, ptrdiff_t so)
+{
+  return col2(dtype, m, X1, n1, sn1, sm1, X2, n2, sn2, sm2, 0,
+              out, so, NULL, 0);
+}  // stats_btstat2()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_bwelcht (int dtype, int m,
+                   const void *X1, int n1, ptrdiff_t sn1, ptrdiff_t sm1,
+                   const void *X2, int n2, ptrdiff_t sn2, ptrdiff_t sm2,
+                   void *out, ptrdiff_t so, void *df, ptrdiff_t sd)
+{
+  return col2(dtype, m, X1, n1, sn1, sm1, X2, n2, sn2, sm2, 1,
+              out, so, df, sd);
+}  // stats_bwelcht()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_bpairedt (int dtype, int m, int n,
+                    const void *X1, ptrdiff_t sn1, ptrdiff_t sm1,
+                    const void *X2, ptrdiff_t sn2, ptrdiff_t sm2,
+                    void *out, ptrdiff_t so)
+{
+  if (!X1 || !X2 || !out || (m < 0) || (n < 2))
+    return -1;
+  switch (dtype) {
+    case STATS_F32:
+      sbpair(m, n, (const float*) X1, sn1, sm1,
+                   (const float*) X2, sn2, sm2, (float*) out, so);
+      return 0;
+    case STATS_F64:
+      dbpair(m, n, (const double*)X1, sn1, sm1,
+                   (const double*)X2, sn2, sm2, (double*)out, so);
+      return 0;
+    default:
+      return -1;
+  }
+}  // stats_bpairedt()
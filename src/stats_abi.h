@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------
+  File    : stats_abi.h
+  Contents: stable C ABI of the shared library (batch functions)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_ABI_H
+#define STATS_ABI_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define STATS_ABI_MAJOR  1      // incremented for incompatible changes
+#define STATS_ABI_MINOR  0      // incremented for added functions
+
+#define STATS_F32  0            // element type float  (numpy.float32)
+#define STATS_F64  1            // element type double (numpy.float64)
+
+#if defined(_WIN32)
+#  define STATS_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#  define STATS_API __attribute__((visibility("default")))
+#else
+#  define STATS_API
+#endif
+
+#define ABI_CHUNK  1024         // number of values per chunk (see below)
+// All batch functions process m data sets (columns) of n values each. The
+// element type is selected at runtime (dtype: STATS_F32 or STATS_F64);
+// data and results are passed as untyped pointers with strides in
+// elements (not bytes, i.e., NumPy's strides divided by the item size):
+// value i of column j is X[i*sn + j*sm], result j is out[j*so]. Hence
+// NumPy arrays in C or Fortran order (and views with arbitrary strides)
+// can be processed without copying.
+//
+// The columns are reduced in chunks of ABI_CHUNK values with the SIMD
+// kernels selected by stats_set_impl() (see stats_abi_init()). Chunks with
+// sn == 1 are processed in place, others are gathered into a buffer on the
+// stack. The chunk results are combined in double precision (Chan et
+// al.). The functions do not allocate memory and do not start threads;
+// they may be called concurrently (e.g., on different columns) once the
+// implementation has been selected.
+//
+// All functions return 0 on success and -1 if an argument is invalid
+// (unknown dtype, too few values, NULL pointers).
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* stats_abi_version
+ * -----------------
+ * returns
+ * the version of the ABI (STATS_ABI_MAJOR * 1000 + STATS_ABI_MINOR)
+ */
+STATS_API int stats_abi_version (void);
+
+/* stats_abi_init
+ * --------------
+ * select the set of implementations (impl: value of stats_flags, e.g.,
+ * 100 = STATS_AUTO; see stats_set_impl()); should be called once before
+ * the functions below are called from several threads
+ *
+ * returns
+ * the selected set of implementations
+ */
+STATS_API int stats_abi_init    (int impl);
+
+/* stats_bmean, stats_bvar, stats_bstd, stats_btstat
+ * -------------------------------------------------
+ * mean, sample variance, sample standard deviation or one-sample t
+ * statistic of each column (n > 1, except for stats_bmean)
+ */
+STATS_API int stats_bmean   (int dtype, const void *X, int n, int m,
+                             ptrdiff_t sn, ptrdiff_t sm,
+                             void *out, ptrdiff_t so);
+STATS_API int stats_bvar    (int dtype, const void *X, int n, int m,
+                             ptrdiff_t sn, ptrdiff_t sm,
+                             void *out, ptrdiff_t so);
+STATS_API int stats_bstd    (int dtype, const void *X, int n, int m,
+                             ptrdiff_t sn, ptrdiff_t sm,
+                             void *out, ptrdiff_t so);
+STATS_API int stats_btstat  (int dtype, const void *X, int n, int m,
+                             ptrdiff_t sn, ptrdiff_t sm,
+                             void *out, ptrdiff_t so);
+
+/* stats_btstat2, stats_bwelcht
+ * ----------------------------
+ * two-sample t statistic (pooled variance) or Welch's t statistic and
+ * degrees of freedom of each pair of columns of X1 (n1 x m) and X2
+ * (n2 x m) (n1, n2 > 1)
+ *
+ * df, sd  buffer for the degrees of freedom (or NULL) and its stride
+ */
+STATS_API int stats_btstat2 (int dtype, int m,
+                             const void *X1, int n1,
+                             ptrdiff_t sn1, ptrdiff_t sm1,
+                             const void *X2, int n2,
+                             ptrdiff_t sn2, ptrdiff_t sm2,
+                             void *out, ptrdiff_t so);
+STATS_API int stats_bwelcht (int dtype, int m,
+                             const void *X1, int n1,
+                             ptrdiff_t sn1, ptrdiff_t sm1,
+                             const void *X2, int n2,
+                             ptrdiff_t sn2, ptrdiff_t sm2,
+                             void *out, ptrdiff_t so,
+                             void *df,  ptrdiff_t sd);
+
+/* stats_bpairedt
+ * --------------
+ * paired t statistic of each pair of columns of X1 and X2 (n x m, n > 1)
+ */
+STATS_API int stats_bpairedt (int dtype, int m, int n,
+                              const void *X1, ptrdiff_t sn1, ptrdiff_t sm1,
+                              const void *X2, ptrdiff_t sn2, ptrdiff_t sm2,
+                              void *out, ptrdiff_t so);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_ABI_H
@@ -0,0 +1,96 @@
+/*----------------------------------------------------------------------------
+  File    : stats_abi_real.c
+  Contents: this file is to be included from stats_abi.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void colstat (const REAL *x, ptrdiff_t ix,
+                     const REAL *y, ptrdiff_t iy, int n,
+                     double *mn, double *q)
+{                               // --- mean and sum of squared deviations
+  REAL   buf[ABI_CHUNK];        // of a strided column x (or x - y,
+  double na = 0, ma = 0, qa = 0;    // if y is not NULL)
+  for (int i = 0; i < n; i += ABI_CHUNK) {
+    int len = (n-i < ABI_CHUNK) ? n-i : ABI_CHUNK;
+    const REAL *p = x + (ptrdiff_t)i*ix;
+    if (y) {                    // gather the differences
+      const REAL *py = y + (ptrdiff_t)i*iy;
+      for (int k = 0; k < len; k++)
+        buf[k] = p[(ptrdiff_t)k*ix] - py[(ptrdiff_t)k*iy];
+      p = buf;
+    }
+    else if (ix != 1) {         // gather the strided values
+      for (int k = 0; k < len; k++)
+        buf[k] = p[(ptrdiff_t)k*ix];
+      p = buf;
+    }
+    double nb = (double)len;    // mean and sum of squared deviations
+    double s  = (double)sum(p, len);    // of the chunk
+    REAL   mc = (REAL)(s/nb);
+    double e  = s/nb - (double)mc;  // (correct for the rounding of mc)
+    double qb = (len > 1) ? (double)varm(p, len, mc)*(nb-1) - nb*e*e : 0;
+    double nt = na + nb, d = s/nb - ma;
+    ma += d*nb/nt;              // combine with the previous chunks
+    qa += qb + d*d*na*nb/nt;    // (Chan et al.)
+    na  = nt;
+  }
+  *mn = ma; *q = qa;
+}  // colstat()
+
+/*--------------------------------------------------------------------------*/
+
+static void bcol (const REAL *X, int n, int m, ptrdiff_t sn, ptrdiff_t sm,
+                  int what, REAL *out, ptrdiff_t so)
+{                               // --- one-sample statistics of columns
+  for (int j = 0; j < m; j++) {
+    double mn, q;
+    colstat(X + (ptrdiff_t)j*sm, sn, NULL, 0, n, &mn, &q);
+    double v = (n > 1) ? q/(double)(n-1) : 0;
+    out[(ptrdiff_t)j*so] = (REAL)((what == COL_MEAN) ? mn
+                                : (what == COL_VAR)  ? v
+                                : (what == COL_STD)  ? sqrt(v)
+                                : mn / sqrt(v/(double)n));
+  }
+}  // bcol()
+
+/*--------------------------------------------------------------------------*/
+
+static void bcol2 (int m, const REAL *X1, int n1, ptrdiff_t sn1,
+                   ptrdiff_t sm1, const REAL *X2, int n2, ptrdiff_t sn2,
+                   ptrdiff_t sm2, int welch, REAL *out, ptrdiff_t so,
+                   REAL *df, ptrdiff_t sd)
+{                               // --- two-sample t tests of columns
+  double f1 = (double)n1, f2 = (double)n2;
+  for (int j = 0; j < m; j++) {
+    double m1, q1, m2, q2, t;
+    colstat(X1 + (ptrdiff_t)j*sm1, sn1, NULL, 0, n1, &m1, &q1);
+    colstat(X2 + (ptrdiff_t)j*sm2, sn2, NULL, 0, n2, &m2, &q2);
+    if (welch) {
+      double a1 = q1/(f1-1)/f1, a2 = q2/(f2-1)/f2;
+      t = (m1 - m2) / sqrt(a1 + a2);
+      if (df) df[(ptrdiff_t)j*sd] = (REAL)((a1+a2)*(a1+a2)
+                                  / (a1*a1/(f1-1) + a2*a2/(f2-1)));
+    }
+    else
+      t = (m1 - m2) / sqrt((q1+q2)/(f1+f2-2) * (1/f1 + 1/f2));
+    out[(ptrdiff_t)j*so] = (REAL)t;
+  }
+}  // bcol2()
+
+/*--------------------------------------------------------------------------*/
+
+static void bpair (int m, int n, const REAL *X1, ptrdiff_t sn1,
+                   ptrdiff_t sm1, const REAL *X2, ptrdiff_t sn2,
+                   ptrdiff_t sm2, REAL *out, ptrdiff_t so)
+{                               // --- paired t tests of columns
+  for (int j = 0; j < m; j++) {
+    double mn, q;
+    colstat(X1 + (ptrdiff_t)j*sm1, sn1, X2 + (ptrdiff_t)j*sm2, sn2, n,
+            &mn, &q);
+    out[(ptrdiff_t)j*so] = (REAL)(mn / sqrt(q/(double)(n-1)/(double)n));
+  }
+}  // bpair()
@@ -0,0 +1,187 @@
+/*----------------------------------------------------------------------------
+  File    : stats_acf.c
+  Contents: autocorrelation functions and autocorrelation-corrected t tests
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "stats_acf.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define PI  3.14159265358979323846
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- FFT workspace
+  int    L;                     // transform length (power of 2)
+  double *w;                    // cos (L/2) and sin (L/2) table
+  double *re, *im;              // real and imaginary parts (L each)
+} fftws;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static int fftlen (int n, int maxlag)
+{                               // --- transform length for the FFT path
+  int L = 2, q = 1;             // (0 if the direct lag sums are faster)
+  while (L < n+maxlag) { L <<= 1; q++; }
+  return ((double)maxlag*(double)n > ACF_FFTCOST*(double)L*(double)q)
+       ? L : 0;
+}  // fftlen()
+
+/*--------------------------------------------------------------------------*/
+
+static int fftinit (fftws *f, int L)
+{                               // --- allocate an FFT workspace
+  f->L  = L;                    // (L: power of 2)
+  f->w  = (double*) malloc((size_t)(3*L) *sizeof(double));
+  if (!f->w) return -1;
+  f->re = f->w  + L;
+  f->im = f->re + L;
+  for (int k = 0; k < L/2; k++) {
+    f->w[k]     = cos(2*PI*(double)k/(double)L);
+    f->w[L/2+k] = sin(2*PI*(double)k/(double)L);
+  }
+  return 0;
+}  // fftinit()
+
+/*--------------------------------------------------------------------------*/
+
+static void fft (fftws *f, int inv)
+{                               // --- in-place radix-2 FFT of re + i im
+  int    L  = f->L;             // (no scaling of the inverse transform)
+  double *re = f->re, *im = f->im;
+  const double *c = f->w, *s = f->w + L/2;
+  for (int i = 1, j = 0; i < L; i++) {  // bit-reversal permutation
+    int b = L >> 1;
+    for ( ; j & b; b >>= 1) j ^= b;
+    j ^= b;
+    if (i < j) {
+      double t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+  double sg = inv ? 1 : -1;     // (sign of the exponent)
+  for (int len = 2; len <= L; len <<= 1) {
+    int h = len >> 1, st = L/len;
+    for (int i = 0; i < L; i += len)
+      for (int k = 0; k < h; k++) {
+        double wr = c[k*st], wi = sg*s[k*st];
+        int    a  = i+k, b = i+k+h;
+        double xr = re[b]*wr - im[b]*wi;
+        double xi = re[b]*wi + im[b]*wr;
+        re[b] = re[a] - xr; im[b] = im[a] - xi;
+        re[a] += xr;        im[a] += xi;
+      }
+  }
+}  // fft()
+
+/*--------------------------------------------------------------------------*/
+
+static void powspec (fftws *f)
+{                               // --- power spectra of the real and the
+  int    L  = f->L;             // imaginary part (X = (Z_k + Z*_{L-k})/2,
+  double *re = f->re, *im = f->im;  // Y = (Z_k - Z*_{L-k})/2i), stored
+  for (int k = 0; k <= L/2; k++) {  // as real and imaginary part
+    int    j  = (L-k) & (L-1);
+    double xr = re[k] + re[j], xi = im[k] - im[j];
+    double yr = im[k] + im[j], yi = re[j] - re[k];
+    double px = 0.25*(xr*xr + xi*xi);
+    double py = 0.25*(yr*yr + yi*yi);
+    re[k] = re[j] = px;
+    im[k] = im[j] = py;
+  }
+}  // powspec()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define sqrt      sqrtf
+#define tres      stres
+#define dot       sdot
+#define mean      smean
+#define varm      svarm
+#define acf       sacf
+#define acft      sacft
+#define acft2     sacft2
+#define acftb     sacftb
+#define acfjob    sacfjob
+#define acfdir    sacfdir
+#define acffft    sacffft
+#define acfpair   sacfpair
+#define acftask   sacftask
+#define acfinf    sacfinf
+#define acfone    sacfone
+#include "stats_acf_real.c"     // single precision versions
+#undef REAL
+#undef sqrt
+#undef tres
+#undef dot
+#undef mean
+#undef varm
+#undef acf
+#undef acft
+#undef acft2
+#undef acftb
+#undef acfjob
+#undef acfdir
+#undef acffft
+#undef acfpair
+#undef acftask
+#undef acfinf
+#undef acfone
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define tres      dtres
+#define dot       ddot
+#define mean      dmean
+#define varm      dvarm
+#define acf       dacf
+#define acft      dacft
+#define acft2     dacft2
+#define acftb     dacftb
+#define acfjob    dacfjob
+#define acfdir    dacfdir
+#define acffft    dacffft
+#define acfpair   dacfpair
+#define acftask   dacftask
+#define acfinf    dacfinf
+#define acfone    dacfone
+#include "stats_acf_real.c"     // double precision versions
+#undef REAL
+#undef tres
+#undef dot
+#undef mean
+#undef varm
+#undef acf
+#undef acft
+#undef acft2
+#undef acftb
+#undef acfjob
+#undef acfdir
+#undef acffft
+#undef acfpair
+#undef acftask
+#undef acfinf
+#undef acfone
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
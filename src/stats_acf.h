@@ -0,0 +1,117 @@
+/*----------------------------------------------------------------------------
+  File    : stats_acf.h
+  Contents: autocorrelation functions and autocorrelation-corrected t tests
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_ACF_H
+#define STATS_ACF_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "stats.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define ACF_FFTCOST  8          // cost of an FFT butterfly relative to
+                                // a (SIMD) term of the direct lag sums
+// For short maximum lags, the lags of each (centered) series are computed
+// directly as dot products with the shifted series (SIMD, O(n maxlag)).
+// If maxlag n > ACF_FFTCOST L log2(L), the autocovariances are instead
+// obtained as the inverse FFT of the power spectrum (radix-2, zero-padded
+// to the smallest power of 2 L >= n + maxlag, O(n log n)). Two real
+// series are transformed at once as the real and imaginary part of one
+// complex series.
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+// The series use the batched column-major layout, i.e., the n values of
+// each of the m series are stored contiguously.
+
+/* acf
+ * ---
+ * autocorrelation functions of m series (thread-parallel)
+ *
+ * r_k = sum_{t=1}^{n-k} (x_t - mean)(x_{t+k} - mean) / sum (x_t - mean)^2
+ * (r_0 = 1; r_k = 0 for k > 0 for a constant series)
+ *
+ * X         series (n x m)
+ * n         length of the series (n > 1)
+ * m         number of series
+ * maxlag    maximum lag (0 <= maxlag < n)
+ * r         buffer for the autocorrelations ((maxlag+1) x m)
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed
+ */
+extern int    sacf   (const float  *X, int n, int m, int maxlag,
+                      float  *r, int nthreads);
+extern int    dacf   (const double *X, int n, int m, int maxlag,
+                      double *r, int nthreads);
+
+/* acft, acft2
+ * -----------
+ * one- and two-sample t tests for autocorrelated series
+ *
+ * The variance of the mean of a series is inflated by the factor
+ * f = 1 + 2 sum_{k=1}^{K} (1 - k/n) r_k, where the sum stops at maxlag or
+ * before the first lag with r_k <= 0 (so that f >= 1). The effective
+ * number of independent values is n/f.
+ *
+ * acft:   t = mean / sqrt(f var/n),  df = n/f - 1
+ * acft2:  t = (mean1 - mean2) / sqrt(a1 + a2),  a_i = f_i var_i/n_i,
+ *         df = (a1 + a2)^2 / (a1^2/(n1/f1 - 1) + a2^2/(n2/f2 - 1))
+ *         (Welch-Satterthwaite with the effective sample sizes)
+ *
+ * returns
+ * t and df (see welcht()); NaN if memory allocation failed
+ */
+extern stres  sacft  (const float  *x, int n, int maxlag);
+extern dtres  dacft  (const double *x, int n, int maxlag);
+extern stres  sacft2 (const float  *x1, const float  *x2, int n1, int n2,
+                      int maxlag);
+extern dtres  dacft2 (const double *x1, const double *x2, int n1, int n2,
+                      int maxlag);
+
+/* acftb
+ * -----
+ * one-sample t tests for m autocorrelated series (thread-parallel,
+ * see acf() and acft())
+ *
+ * t, df     buffers for the t statistics and degrees of freedom (m)
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed
+ */
+extern int    sacftb (const float  *X, int n, int m, int maxlag,
+                      float  *t, float  *df, int nthreads);
+extern int    dacftb (const double *X, int n, int m, int maxlag,
+                      double *t, double *df, int nthreads);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define acf     dacf
+#    define acft    dacft
+#    define acft2   dacft2
+#    define acftb   dacftb
+#  else
+#    define acf     sacf
+#    define acft    sacft
+#    define acft2   sacft2
+#    define acftb   sacftb
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_ACF_H
@@ -0,0 +1,179 @@
+/*----------------------------------------------------------------------------
+  File    : stats_acf_real.c
+  Contents: this file is to be included from stats_acf.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- job for the thread-parallel loops
+  const REAL *X;                // series (n x m)
+  int        n;                 // length of the series
+  int        m;                 // number of series
+  int        maxlag;            // maximum lag
+  REAL       *r;                // autocorrelations ((maxlag+1) x m)
+  REAL       *t, *df;           // t statistics and df (m) (acftb)
+  int        err;               // error indicator
+} acfjob;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void acfdir (const REAL *x, int n, int maxlag, REAL *xc, REAL *r)
+{                               // --- autocorrelations (direct lag sums)
+  REAL m = mean(x, n);
+  for (int i = 0; i < n; i++)   // center the series
+    xc[i] = x[i] - m;
+  REAL c0 = dot(xc, xc, n);
+  r[0] = 1;
+  for (int k = 1; k <= maxlag; k++)
+    r[k] = (c0 > 0) ? dot(xc, xc+k, n-k) / c0 : 0;
+}  // acfdir()
+
+/*--------------------------------------------------------------------------*/
+
+static void acffft (fftws *f, const REAL *x, const REAL *y, int n,
+                    int maxlag, REAL *rx, REAL *ry)
+{                               // --- autocorrelations of two series
+  int    L  = f->L;             // (FFT of x + iy; y and ry may be NULL)
+  double *re = f->re, *im = f->im;
+  REAL   mx = mean(x, n);
+  REAL   my = y ? mean(y, n) : 0;
+  for (int i = 0; i < n; i++) {
+    re[i] = (double)(x[i] - mx);
+    im[i] = y ? (double)(y[i] - my) : 0;
+  }
+  for (int i = n; i < L; i++)   // zero-pad (no wrap-around up to maxlag)
+    re[i] = im[i] = 0;
+  fft(f, 0);                    // autocovariances (times n L) as the
+  powspec(f);                   // inverse transform of the power spectra
+  fft(f, 1);
+  rx[0] = 1;
+  for (int k = 1; k <= maxlag; k++)
+    rx[k] = (re[0] > 0) ? (REAL)(re[k] / re[0]) : 0;
+  if (!ry) return;
+  ry[0] = 1;
+  for (int k = 1; k <= maxlag; k++)
+    ry[k] = (im[0] > 0) ? (REAL)(im[k] / im[0]) : 0;
+}  // acffft()
+
+/*--------------------------------------------------------------------------*/
+
+static REAL acfinf (const REAL *r, int n, int maxlag)
+{                               // --- variance inflation of the mean
+  double f = 1;                 // (stop before the first r_k <= 0)
+  for (int k = 1; (k <= maxlag) && (r[k] > 0); k++)
+    f += 2 * (1 - (double)k/(double)n) * (double)r[k];
+  return (REAL)f;
+}  // acfinf()
+
+/*--------------------------------------------------------------------------*/
+
+static void acftask (void *data, int tid, int beg, int end)
+{                               // --- process a range of pairs of series
+  acfjob *j = (acfjob*)data;
+  int  n = j->n, K = j->maxlag;
+  REAL *buf = (REAL*) malloc((size_t)(n + 2*(K+1)) *sizeof(REAL));
+  fftws f = { 0, NULL, NULL, NULL };
+  int   L = fftlen(n, K);       // (0: direct lag sums)
+  if (!buf || (L && (fftinit(&f, L) != 0))) {
+    free(buf); j->err = -1; return; }
+
+  for (int p = beg; p < end; p++) {
+    int  v   = 2*p;
+    int  two = (v+1 < j->m);    // (the last pair may be a single series)
+    const REAL *x = j->X + (size_t)v*(size_t)n;
+    REAL *rx = j->r ? j->r + (size_t)v*(size_t)(K+1) : buf + n;
+    REAL *ry = two  ? rx + (K+1) : NULL;
+    if (L)
+      acffft(&f, x, two ? x+n : NULL, n, K, rx, ry);
+    else {
+      acfdir(x, n, K, buf, rx);
+      if (two) acfdir(x+n, n, K, buf, ry);
+    }
+    if (!j->t) continue;
+    for (int i = 0; i < 1+two; i++) {   // one-sample t tests
+      const REAL *y = x + (size_t)i*(size_t)n;
+      REAL m  = mean(y, n);
+      REAL fi = acfinf(i ? ry : rx, n, K);
+      j->t [v+i] = m / sqrt(fi * varm(y, n, m) / (REAL)n);
+      j->df[v+i] = (REAL)n/fi - 1;
+    }
+  }
+  free(f.w);
+  free(buf);
+}  // acftask()
+
+/*--------------------------------------------------------------------------*/
+
+static REAL acfone (const REAL *x, int n, int maxlag)
+{                               // --- variance inflation of one series
+  REAL *r = (REAL*) malloc((size_t)(maxlag+1) *sizeof(REAL));
+  if (!r) return (REAL)NAN;
+  acfjob j = { .X = x, .n = n, .m = 1, .maxlag = maxlag, .r = r,
+               .t = NULL, .df = NULL, .err = 0 };
+  acftask(&j, 0, 0, 1);
+  REAL f = j.err ? (REAL)NAN : acfinf(r, n, maxlag);
+  free(r);
+  return f;
+}  // acfone()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+int acf (const REAL *X, int n, int m, int maxlag, REAL *r, int nthreads)
+{
+  assert(X && (n > 1) && (m > 0) && (maxlag >= 0) && (maxlag < n) && r);
+
+  acfjob j = { .X = X, .n = n, .m = m, .maxlag = maxlag, .r = r,
+               .t = NULL, .df = NULL, .err = 0 };
+  stats_parfor(nthreads, (m+1)/2, acftask, &j);
+  return j.err;
+}  // acf()
+
+/*--------------------------------------------------------------------------*/
+
+tres acft (const REAL *x, int n, int maxlag)
+{
+  assert(x && (n > 1) && (maxlag >= 0) && (maxlag < n));
+
+  REAL m = mean(x, n);
+  REAL f = acfone(x, n, maxlag);
+  tres res = { .t  = m / sqrt(f * varm(x, n, m) / (REAL)n),
+               .df = (REAL)n/f - 1 };
+  return res;
+}  // acft()
+
+/*--------------------------------------------------------------------------*/
+
+tres acft2 (const REAL *x1, const REAL *x2, int n1, int n2, int maxlag)
+{
+  assert(x1 && x2 && (n1 > 1) && (n2 > 1) && (maxlag >= 0)
+      && (maxlag < n1) && (maxlag < n2));
+
+  REAL m1 = mean(x1, n1), f1 = acfone(x1, n1, maxlag);
+  REAL m2 = mean(x2, n2), f2 = acfone(x2, n2, maxlag);
+  REAL a1 = f1 * varm(x1, n1, m1) / (REAL)n1;
+  REAL a2 = f2 * varm(x2, n2, m2) / (REAL)n2;
+  REAL e1 = (REAL)n1/f1 - 1, e2 = (REAL)n2/f2 - 1;
+  tres res = { .t  = (m1 - m2) / sqrt(a1 + a2),
+               .df = (a1 + a2) * (a1 + a2) / (a1*a1/e1 + a2*a2/e2) };
+  return res;
+}  // acft2()
+
+/*--------------------------------------------------------------------------*/
+
+int acftb (const REAL *X, int n, int m, int maxlag,
+           REAL *t, REAL *df, int nthreads)
+{
+  assert(X && (n > 1) && (m > 0) && (maxlag >= 0) && (maxlag < n)
+      && t && df);
+
+  acfjob j = { .X = X, .n = n, .m = m, .maxlag = maxlag, .r = NULL,
+               .t = t, .df = df, .err = 0 };
+  stats_parfor(nthreads, (m+1)/2, acftask, &j);
+  return j.err;
+}  // acftb()
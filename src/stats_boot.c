@@ -0,0 +1,77 @@
+/*----------------------------------------------------------------------------
+  File    : stats_boot.c
+  Contents: bootstrap confidence intervals
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "stats_boot.h"
+#include "stats_dist.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static uint64_t mix (uint64_t z)
+{                               // --- mix the bits of a 64 bit value
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;  // (finalizer of
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;  // splitmix64)
+  return z ^ (z >> 31);
+}  // mix()
+
+/*--------------------------------------------------------------------------*/
+
+static int draw (uint64_t key, uint64_t ctr, int n)
+{                               // --- draw an index from {0, ..., n-1}
+  uint64_t r = mix(key + ctr * 0x9e3779b97f4a7c15ULL);
+  return (int)(((r >> 32) * (uint64_t)n) >> 32);
+}  // draw()                    // (counter-based: no state)
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define boot      sboot
+#define bootjob   sbootjob
+#define boottask  sboottask
+#define bootcmp   sbootcmp
+#define bootqnt   sbootqnt
+#include "def-or-undef-functions.inc"
+#include "stats_boot_real.c"    // single precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef boot
+#undef bootjob
+#undef boottask
+#undef bootcmp
+#undef bootqnt
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define boot      dboot
+#define bootjob   dbootjob
+#define boottask  dboottask
+#define bootcmp   dbootcmp
+#define bootqnt   dbootqnt
+#include "def-or-undef-functions.inc"
+#include "stats_boot_real.c"    // double precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef boot
+#undef bootjob
+#undef boottask
+#undef bootcmp
+#undef bootqnt
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
@@ -0,0 +1,99 @@
+/*----------------------------------------------------------------------------
+  File    : stats_boot.h
+  Contents: bootstrap confidence intervals
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_BOOT_H
+#define STATS_BOOT_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "stats.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define BOOT_PERC   0           // percentile interval
+#define BOOT_BCA    1           // bias-corrected and accelerated interval
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* boot
+ * ----
+ * bootstrap confidence interval of a statistic
+ *
+ * The resamples are drawn with replacement within each stratum (sample)
+ * using a counter-based random number generator: draw j of resample b
+ * only depends on seed, b and j. The results are therefore reproducible
+ * and independent of the number of threads. The resampled data are
+ * generated on the fly (one buffer per thread); the index matrix of the
+ * resamples is never materialized. For mean_w, sum_w and mdiff_w, the
+ * statistic is accumulated directly from the drawn values (sufficient
+ * statistics) without copying the resample.
+ *
+ * a         data (laid out as for the *_w wrappers)
+ *
+ * n         n[0] - number of data sets in stratum #1
+ *           n[1] - number of data sets in stratum #2
+ *           ...  - ...
+ *
+ * ns        number of strata (e.g., 1 for mean_w, 2 for tstat2_w)
+ *
+ * blk       number of blocks per stratum that are resampled jointly
+ *           1 -> independent samples (mean_w, mdiff_w, tstat2_w, ...)
+ *           2 -> paired samples (pairedt_w: ns = 1, didt_w: ns = 2)
+ *           (stratum s occupies blk*n[s] consecutive values of a)
+ *
+ * func      mean_w, mdiff_w, tstat_w, tstat2_w, pairedt_w, didt_w, ...
+ *
+ * nb        number of bootstrap resamples
+ *
+ * seed      seed of the random number generator
+ *
+ * alpha     the interval has coverage 1-alpha (e.g., 0.05)
+ *
+ * method    BOOT_PERC or BOOT_BCA
+ *           (BCa needs func to be defined for n[s]-1 data sets, as the
+ *           acceleration is estimated with the jackknife)
+ *
+ * ci        buffer for the lower and upper bound of the interval
+ *
+ * bs        buffer for the nb bootstrap statistics (sorted on return)
+ *           or NULL
+ *
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * the statistic computed on the original data; NaN if memory allocation
+ * failed
+ */
+extern float  sboot (const float  *a, const int *n, int ns, int blk,
+                     Func1s *func, int nb, unsigned long long seed,
+                     float  alpha, int method, float  *ci, float  *bs,
+                     int nthreads);
+extern double dboot (const double *a, const int *n, int ns, int blk,
+                     Func1d *func, int nb, unsigned long long seed,
+                     double alpha, int method, double *ci, double *bs,
+                     int nthreads);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic name
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define boot      dboot
+#  else
+#    define boot      sboot
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_BOOT_H
@@ -0,0 +1,169 @@
+/*----------------------------------------------------------------------------
+  File    : stats_boot_real.c
+  Contents: this file is to be included from stats_boot.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- job for the thread-parallel loop
+  const REAL *a;                // data
+  const int  *n;                // sizes of the strata
+  int        ns;                // number of strata
+  int        blk;               // number of blocks per stratum
+  Func1      *func;             // statistic
+  int        fast;              // fast path (0: none, 1: sum, 2: mean,
+                                // 3: mean difference)
+  int        nval;              // total number of values
+  int        nunit;             // total number of resampled units
+  uint64_t   key;               // key of the random number generator
+  REAL       *bs;               // bootstrap statistics
+  int        err;               // error indicator
+} bootjob;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void boottask (void *data, int tid, int beg, int end)
+{                               // --- compute bootstrap statistics
+  bootjob *j = (bootjob*)data;
+  const REAL *a = j->a;
+  const int  *n = j->n;
+  REAL *tmp = NULL;
+  if (!j->fast && !(tmp = (REAL*) malloc((size_t)j->nval *sizeof(REAL)))) {
+    j->err = -1; return; }      // buffer for a resample
+
+  for (int b = beg; b < end; b++) {
+    uint64_t ctr = (uint64_t)b * (uint64_t)j->nunit;
+    if (j->fast) {              // accumulate the sums directly
+      REAL s[2] = { 0, 0 };
+      for (int st = 0, o = 0; st < j->ns; o += n[st++])
+        for (int i = 0; i < n[st]; i++)
+          s[st] += a[o + draw(j->key, ctr++, n[st])];
+      j->bs[b] = (j->fast == 1) ? s[0]
+               : (j->fast == 2) ? s[0]/(REAL)n[0]
+               : s[0]/(REAL)n[0] - s[1]/(REAL)n[1];
+      continue;
+    }
+    for (int st = 0, o = 0; st < j->ns; o += j->blk*n[st++]) {
+      for (int i = 0; i < n[st]; i++) {
+        int k = draw(j->key, ctr++, n[st]);
+        for (int c = 0; c < j->blk; c++)  // draw a unit (all blocks)
+          tmp[o + c*n[st] + i] = a[o + c*n[st] + k];
+      }
+    }
+    j->bs[b] = j->func(tmp, n); // evaluate the statistic
+  }
+  free(tmp);
+}  // boottask()
+
+/*--------------------------------------------------------------------------*/
+
+static int bootcmp (const void *p1, const void *p2)
+{                               // --- compare two statistics
+  REAL x = *(const REAL*)p1, y = *(const REAL*)p2;
+  return (x < y) ? -1 : (x > y) ? 1 : 0;
+}  // bootcmp()
+
+/*--------------------------------------------------------------------------*/
+
+static REAL bootqnt (const REAL *bs, int nb, double p)
+{                               // --- quantile of sorted statistics
+  double h = p * (double)(nb-1);
+  if (h <= 0)          return bs[0];
+  if (h >= (double)(nb-1)) return bs[nb-1];
+  int    i = (int)h;
+  return (REAL)((double)bs[i] + (h-(double)i)*(double)(bs[i+1]-bs[i]));
+}  // bootqnt()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+REAL boot (const REAL *a, const int *n, int ns, int blk,
+           Func1 *func, int nb, unsigned long long seed,
+           REAL alpha, int method, REAL *ci, REAL *bs,
+           int nthreads)
+{
+  assert(a && n && (ns > 0) && (blk > 0) && func && (nb > 1));
+  assert((alpha > 0) && (alpha < 1) && ci);
+
+  REAL theta = func(a, n);      // statistic of the original data
+
+  bootjob j = { .a = a, .n = n, .ns = ns, .blk = blk, .func = func,
+                .fast = 0, .nval = 0, .nunit = 0,
+                .key = mix((uint64_t)seed), .bs = bs, .err = 0 };
+  for (int st = 0; st < ns; st++) {
+    j.nunit += n[st];
+    j.nval  += blk*n[st];
+  }
+  if      ((func == sum_w)   && (ns == 1) && (blk == 1)) j.fast = 1;
+  else if ((func == mean_w)  && (ns == 1) && (blk == 1)) j.fast = 2;
+  else if ((func == mdiff_w) && (ns == 2) && (blk == 1)) j.fast = 3;
+
+  if (!bs && !(j.bs = (REAL*) malloc((size_t)nb *sizeof(REAL))))
+    return (REAL)NAN;
+  stats_parfor(nthreads, nb, boottask, &j);
+  if (j.err != 0) {
+    if (!bs) free(j.bs);
+    return (REAL)NAN;
+  }
+  qsort(j.bs, (size_t)nb, sizeof(REAL), bootcmp);
+
+  double pl = alpha/2, ph = 1-alpha/2;  // percentile interval
+  if (method == BOOT_BCA) {     // bias-corrected and accelerated interval
+    // bias correction
+    int cnt = 0;
+    while ((cnt < nb) && (j.bs[cnt] < theta)) cnt++;
+    double z0 = norminv((cnt > 0) ? ((cnt < nb) ? (double)cnt/(double)nb
+                                                : 1-0.5/(double)nb)
+                                  : 0.5/(double)nb, DIST_EXACT);
+
+    // acceleration (jackknife)
+    double *jk = (double*) malloc((size_t)j.nunit *sizeof(double)
+                                + (size_t)j.nval  *sizeof(REAL)
+                                + (size_t)ns      *sizeof(int));
+    if (!jk) {
+      if (!bs) free(j.bs);
+      return (REAL)NAN;
+    }
+    REAL   *tmp = (REAL*)(jk + j.nunit);
+    int    *nj  = (int*)(tmp + j.nval);
+    double  jm = 0;
+    for (int st = 0; st < ns; st++)
+      nj[st] = n[st];
+    for (int st = 0, o = 0, u = 0; st < ns; o += blk*n[st++]) {
+      nj[st] = n[st]-1;
+      for (int i = 0; i < n[st]; i++, u++) {
+        for (int t = 0, p = 0, q = 0; t < ns; t++) {
+          for (int c = 0; c < blk; c++)   // copy the data without
+            for (int l = 0; l < n[t]; l++, q++)  // unit i of stratum st
+              if ((t != st) || (l != i)) tmp[p++] = a[q];
+        }
+        jk[u] = (double)func(tmp, nj);
+        jm   += jk[u];
+      }
+      nj[st] = n[st];
+    }
+    jm /= (double)j.nunit;
+    double s2 = 0, s3 = 0;
+    for (int u = 0; u < j.nunit; u++) {
+      double d = jm - jk[u];
+      s2 += d*d; s3 += d*d*d;
+    }
+    free(jk);
+    double acc = (s2 > 0) ? s3 / (6 * pow(s2, 1.5)) : 0;
+
+    double zl = z0 + norminv(pl, DIST_EXACT);
+    double zh = z0 + norminv(ph, DIST_EXACT);
+    pl = normcdf(z0 + zl/(1 - acc*zl));
+    ph = normcdf(z0 + zh/(1 - acc*zh));
+  }
+  ci[0] = bootqnt(j.bs, nb, pl);
+  ci[1] = bootqnt(j.bs, nb, ph);
+
+  if (!bs) free(j.bs);
+  return theta;
+}  // boot()
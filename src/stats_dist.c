@@ -0,0 +1,222 @@
+/*----------------------------------------------------------------------------
+  File    : stats_dist.c
+  Contents: conversion of test statistics to p values and z scores
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include "stats_dist.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define BLKSIZE  16             // number of arguments per block
+#define TINY     1e-300         // to avoid division by zero (Lentz)
+#define SQRT2PI  2.50662827463100050242   // sqrt(2*pi)
+#define SQRT2    1.41421356237309504880   // sqrt(2)
+#define LNSQRT2PI 0.918938533204672741780  // log(sqrt(2*pi))
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static double lgcor (double x)
+{                               // --- lgamma(x) - Stirling approx.
+  double r = 1/(x*x);           // (for x >= 10)
+  return (1/12.0 - r*(1/360.0 - r*(1/1260.0 - r*(1/1680.0 - r/1188.0)))) / x;
+}  // lgcor()
+
+/*--------------------------------------------------------------------------*/
+
+static double lbeta (double a, double b)
+{                               // --- log of the beta function
+  double p = (a < b) ? a : b;   // (avoids the cancellation of
+  double q = (a < b) ? b : a;   // lgamma(a+b) - lgamma(b) for large b)
+  if (p >= 10)
+    return -0.5*log(q) + LNSQRT2PI + lgcor(p) + lgcor(q) - lgcor(p+q)
+         + (p-0.5)*log(p/(p+q)) + q*log1p(-p/(p+q));
+  if (q >= 10)
+    return lgamma(p) + lgcor(q) - lgcor(p+q) + p - p*log(p+q)
+         + (q-0.5)*log1p(-p/(p+q));
+  return lgamma(p) + lgamma(q) - lgamma(p+q);
+}  // lbeta()
+
+/*--------------------------------------------------------------------------*/
+
+static void ibetablk (const double *x, const double *y,
+                      const double *a, const double *b,
+                      int n, int mode, double *r)
+{                               // --- I_x(a,b) for a block of arguments
+                                // (y = 1-x, passed to avoid cancellation)
+  double eps   = (mode == DIST_FAST) ? 1e-7 : 4*DBL_EPSILON;
+  int    maxit = (mode == DIST_FAST) ? 64   : 512;
+  double xx[BLKSIZE], yy[BLKSIZE], aa[BLKSIZE], bb[BLKSIZE];
+  double c[BLKSIZE], d[BLKSIZE], h[BLKSIZE], f[BLKSIZE];
+  int    sw[BLKSIZE], on[BLKSIZE];
+
+  assert(n <= BLKSIZE);
+  for (int l = 0; l < n; l++) { // use the symmetry relation
+    sw[l] = (x[l] > (a[l]+1) / (a[l]+b[l]+2));  // for faster convergence
+    xx[l] = sw[l] ? y[l] : x[l];
+    yy[l] = sw[l] ? x[l] : y[l];
+    aa[l] = sw[l] ? b[l] : a[l];
+    bb[l] = sw[l] ? a[l] : b[l];
+    on[l] = (xx[l] > 0) && (xx[l] < 1);
+    double lx = (xx[l] > 0.5) ? log1p(-yy[l]) : log(xx[l]);
+    double ly = (yy[l] > 0.5) ? log1p(-xx[l]) : log(yy[l]);
+    f[l]  = on[l] ? exp(aa[l]*lx + bb[l]*ly - lbeta(aa[l], bb[l])) / aa[l]
+                  : 0;
+    c[l]  = 1;                  // compute the prefactor and
+    d[l]  = 1 - (aa[l]+bb[l]) * xx[l] / (aa[l]+1);  // initialize the
+    if (fabs(d[l]) < TINY) d[l] = TINY;             // continued fraction
+    d[l]  = 1/d[l];
+    h[l]  = d[l];
+  }
+
+  // evaluate the continued fractions in lockstep (modified Lentz)
+  for (int m = 1, act = 1; act && (m <= maxit); m++) {
+    act = 0;
+    double md = (double)m;
+    for (int l = 0; l < n; l++) {
+      double e, del;            // even step
+      e    = md*(bb[l]-md)*xx[l] / ((aa[l]-1+2*md)*(aa[l]+2*md));
+      d[l] = 1 + e*d[l]; if (fabs(d[l]) < TINY) d[l] = TINY;
+      c[l] = 1 + e/c[l]; if (fabs(c[l]) < TINY) c[l] = TINY;
+      d[l] = 1/d[l];
+      h[l] *= on[l] ? d[l]*c[l] : 1;
+      e    = -(aa[l]+md)*(aa[l]+bb[l]+md)*xx[l]
+           / ((aa[l]+2*md)*(aa[l]+1+2*md));     // odd step
+      d[l] = 1 + e*d[l]; if (fabs(d[l]) < TINY) d[l] = TINY;
+      c[l] = 1 + e/c[l]; if (fabs(c[l]) < TINY) c[l] = TINY;
+      d[l] = 1/d[l];
+      del  = d[l]*c[l];
+      h[l] *= on[l] ? del : 1;
+      on[l] = on[l] && (fabs(del-1) >= eps);
+      act  |= on[l];            // deactivate converged lanes
+    }
+  }
+
+  for (int l = 0; l < n; l++) {
+    double v = f[l]*h[l];
+    if (xx[l] <= 0) v = 0;      // handle the boundaries
+    if (xx[l] >= 1) v = 1;
+    r[l] = sw[l] ? 1-v : v;
+  }
+}  // ibetablk()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+double normcdf (double z)
+{
+  return 0.5 * erfc(-z / SQRT2);
+}  // normcdf()
+
+/*--------------------------------------------------------------------------*/
+
+double norminv (double p, int mode)
+{
+  static const double a[] = {
+    -3.969683028665376e+01,  2.209460984245205e+02, -2.759285104469687e+02,
+     1.383577518672690e+02, -3.066479806614716e+01,  2.506628277459239e+00 };
+  static const double b[] = {
+    -5.447609879822406e+01,  1.615858368580409e+02, -1.556989798598866e+02,
+     6.680131188771972e+01, -1.328068155288572e+01 };
+  static const double c[] = {
+    -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+    -2.549732539343734e+00,  4.374664141464968e+00,  2.938163982698783e+00 };
+  static const double d[] = {
+     7.784695709041462e-03,  3.224671290700398e-01,  2.445134137142996e+00,
+     3.754408661907416e+00 };
+  if (!(p > 0)) return -INFINITY;
+  if (!(p < 1)) return +INFINITY;
+
+  double q, r, z;
+  if (p < 0.02425) {            // lower tail
+    q = sqrt(-2*log(p));
+    z = (((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])
+      / ((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1);
+  }
+  else if (p > 1-0.02425) {     // upper tail
+    q = sqrt(-2*log(1-p));
+    z = -(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5])
+      /  ((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1);
+  }
+  else {                        // central region
+    q = p - 0.5;
+    r = q*q;
+    z = (((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q
+      / (((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1);
+  }
+  if (mode == DIST_FAST)        // relative error < 1.15e-9
+    return z;
+
+  double e = normcdf(z) - p;    // refine with one step of Halley's method
+  double u = e * SQRT2PI * exp(z*z/2);
+  return z - u/(1 + z*u/2);
+}  // norminv()
+
+/*--------------------------------------------------------------------------*/
+
+void ibeta (const double *x, const double *a, const double *b,
+            int n, int mode, double *r)
+{
+  assert(x && a && b && (n >= 0) && r);
+
+  double y[BLKSIZE];
+  for (int i = 0; i < n; i += BLKSIZE) {
+    int m = (n-i < BLKSIZE) ? n-i : BLKSIZE;
+    for (int l = 0; l < m; l++)
+      y[l] = 1 - x[i+l];
+    ibetablk(x+i, y, a+i, b+i, m, mode, r+i);
+  }
+}  // ibeta()
+
+/*--------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL  float             // (re)define REAL to be float
+#define t2p   st2p
+#define t2z   st2z
+#define f2p   sf2p
+#define f2z   sf2z
+#define tblk  stblk
+#define fblk  sfblk
+#include "stats_dist_real.c"    // single precision versions
+#undef REAL
+#undef t2p
+#undef t2z
+#undef f2p
+#undef f2z
+#undef tblk
+#undef fblk
+/*--------------------------------------------------------------------------*/
+#define REAL  double            // (re)define REAL to be double
+#define t2p   dt2p
+#define t2z   dt2z
+#define f2p   df2p
+#define f2z   df2z
+#define tblk  dtblk
+#define fblk  dfblk
+#include "stats_dist_real.c"    // double precision versions
+#undef REAL
+#undef t2p
+#undef t2z
+#undef f2p
+#undef f2z
+#undef tblk
+#undef fblk
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
@@ -0,0 +1,121 @@
+/*----------------------------------------------------------------------------
+  File    : stats_dist.h
+  Contents: conversion of test statistics to p values and z scores
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_DIST_H
+#define STATS_DIST_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define DIST_EXACT  0           // full double precision
+#define DIST_FAST   1           // (about) single precision, faster
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* normcdf
+ * -------
+ * cumulative distribution function of the standard normal distribution
+ */
+extern double normcdf (double z);
+
+/* norminv
+ * -------
+ * inverse of the cumulative distribution function of the standard normal
+ * distribution (Acklam's rational approximation, refined by one step of
+ * Halley's method for mode == DIST_EXACT)
+ */
+extern double norminv (double p, int mode);
+
+/* ibeta
+ * -----
+ * regularized incomplete beta function I_x(a,b) for arrays of arguments
+ *
+ * The continued fraction is evaluated for blocks of arguments in
+ * lockstep, which allows the compiler to vectorize the iterations.
+ *
+ * x, a, b  arguments (n values each)
+ * n        number of arguments
+ * mode     DIST_EXACT or DIST_FAST (see above)
+ * r        buffer for the n results
+ */
+extern void   ibeta   (const double *x, const double *a, const double *b,
+                       int n, int mode, double *r);
+
+/* t2p, t2z
+ * --------
+ * convert t statistics to p values or to equivalent z scores
+ *
+ * The z score has the same (signed) tail probability under the standard
+ * normal distribution as t has under the t distribution with df degrees
+ * of freedom.
+ *
+ * t      t statistics (n values)
+ * df     degrees of freedom
+ * inc    increment for df: 0 -> one value for all t, 1 -> one value per t
+ *        (e.g., the df of welcht())
+ * n      number of t statistics
+ * tail   2 -> two-sided, 1 -> upper tail P(T >= t), -1 -> lower tail
+ *        (t2p only)
+ * mode   DIST_EXACT or DIST_FAST
+ * p, z   buffer for the n results (may be the same as t)
+ */
+extern void st2p (const float  *t, const float  *df, int inc, int n,
+                  int tail, int mode, float  *p);
+extern void dt2p (const double *t, const double *df, int inc, int n,
+                  int tail, int mode, double *p);
+extern void st2z (const float  *t, const float  *df, int inc, int n,
+                  int mode, float  *z);
+extern void dt2z (const double *t, const double *df, int inc, int n,
+                  int mode, double *z);
+
+/* f2p, f2z
+ * --------
+ * convert F statistics to (upper tail) p values or to equivalent z scores
+ *
+ * f         F statistics (n values)
+ * df1, df2  degrees of freedom (numerator, denominator)
+ * inc       increment for df1 and df2 (0 or 1, see t2p)
+ * n         number of F statistics
+ * mode      DIST_EXACT or DIST_FAST
+ * p, z      buffer for the n results (may be the same as f)
+ */
+extern void sf2p (const float  *f, const float  *df1, const float  *df2,
+                  int inc, int n, int mode, float  *p);
+extern void df2p (const double *f, const double *df1, const double *df2,
+                  int inc, int n, int mode, double *p);
+extern void sf2z (const float  *f, const float  *df1, const float  *df2,
+                  int inc, int n, int mode, float  *z);
+extern void df2z (const double *f, const double *df1, const double *df2,
+                  int inc, int n, int mode, double *z);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define t2p   dt2p
+#    define t2z   dt2z
+#    define f2p   df2p
+#    define f2z   df2z
+#  else
+#    define t2p   st2p
+#    define t2z   st2z
+#    define f2p   sf2p
+#    define f2z   sf2z
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_DIST_H
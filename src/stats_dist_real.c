@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------
+  File    : stats_dist_real.c
+  Contents: this file is to be included from stats_dist.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void tblk (const REAL *t, const REAL *df, int inc, int n,
+                  int mode, double *q)
+{                               // --- P(T >= |t|) for a block
+  double x[BLKSIZE], y[BLKSIZE], a[BLKSIZE], b[BLKSIZE];
+  for (int l = 0; l < n; l++) {
+    double v = (double)df[l*inc];
+    double u = (double)t[l];
+    x[l] = v   / (v + u*u);     // P(T >= |t|) = I_x(df/2, 1/2) / 2
+    y[l] = u*u / (v + u*u);     // with x = df/(df+t^2)
+    a[l] = v/2;
+    b[l] = 0.5;
+  }
+  ibetablk(x, y, a, b, n, mode, q);
+  for (int l = 0; l < n; l++)
+    q[l] *= 0.5;
+}  // tblk()
+
+/*--------------------------------------------------------------------------*/
+
+static void fblk (const REAL *f, const REAL *df1, const REAL *df2,
+                  int inc, int n, int mode, double *q)
+{                               // --- P(F >= f) for a block
+  double x[BLKSIZE], y[BLKSIZE], a[BLKSIZE], b[BLKSIZE];
+  for (int l = 0; l < n; l++) {
+    double v1 = (double)df1[l*inc];
+    double v2 = (double)df2[l*inc];
+    double u  = (double)f[l];
+    if (u < 0) u = 0;
+    x[l] = v2   / (v2 + v1*u);  // P(F >= f) = I_x(df2/2, df1/2)
+    y[l] = v1*u / (v2 + v1*u);  // with x = df2/(df2+df1*f)
+    a[l] = v2/2;
+    b[l] = v1/2;
+  }
+  ibetablk(x, y, a, b, n, mode, q);
+}  // fblk()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+void t2p (const REAL *t, const REAL *df, int inc, int n,
+          int tail, int mode, REAL *p)
+{
+  assert(t && df && ((inc == 0) || (inc == 1)) && (n >= 0) && p);
+  assert((tail == 2) || (tail == 1) || (tail == -1));
+
+  double q[BLKSIZE];
+  for (int i = 0; i < n; i += BLKSIZE) {
+    int m = (n-i < BLKSIZE) ? n-i : BLKSIZE;
+    tblk(t+i, df+i*inc, inc, m, mode, q);
+    for (int l = 0; l < m; l++) {
+      REAL u = t[i+l];
+      double v = (tail == 2) ? 2*q[l]
+               : ((tail > 0) == (u >= 0)) ? q[l] : 1-q[l];
+      p[i+l] = (REAL)((v < 1) ? v : 1);
+    }
+  }
+}  // t2p()
+
+/*--------------------------------------------------------------------------*/
+
+void t2z (const REAL *t, const REAL *df, int inc, int n,
+          int mode, REAL *z)
+{
+  assert(t && df && ((inc == 0) || (inc == 1)) && (n >= 0) && z);
+
+  double q[BLKSIZE];
+  for (int i = 0; i < n; i += BLKSIZE) {
+    int m = (n-i < BLKSIZE) ? n-i : BLKSIZE;
+    tblk(t+i, df+i*inc, inc, m, mode, q);
+    for (int l = 0; l < m; l++) {
+      double v = norminv(q[l], mode);       // (v <= 0, use the smaller
+      z[i+l] = (REAL)((t[i+l] > 0) ? -v : v); // tail for accuracy)
+    }
+  }
+}  // t2z()
+
+/*--------------------------------------------------------------------------*/
+
+void f2p (const REAL *f, const REAL *df1, const REAL *df2,
+          int inc, int n, int mode, REAL *p)
+{
+  assert(f && df1 && df2 && ((inc == 0) || (inc == 1)) && (n >= 0) && p);
+
+  double q[BLKSIZE];
+  for (int i = 0; i < n; i += BLKSIZE) {
+    int m = (n-i < BLKSIZE) ? n-i : BLKSIZE;
+    fblk(f+i, df1+i*inc, df2+i*inc, inc, m, mode, q);
+    for (int l = 0; l < m; l++)
+      p[i+l] = (REAL)q[l];
+  }
+}  // f2p()
+
+/*--------------------------------------------------------------------------*/
+
+void f2z (const REAL *f, const REAL *df1, const REAL *df2,
+          int inc, int n, int mode, REAL *z)
+{
+  assert(f && df1 && df2 && ((inc == 0) || (inc == 1)) && (n >= 0) && z);
+
+  double q[BLKSIZE];
+  for (int i = 0; i < n; i += BLKSIZE) {
+    int m = (n-i < BLKSIZE) ? n-i : BLKSIZE;
+    fblk(f+i, df1+i*inc, df2+i*inc, inc, m, mode, q);
+    for (int l = 0; l < m; l++)
+      z[i+l] = (REAL)-norminv(q[l], mode);
+  }
+}  // f2z()
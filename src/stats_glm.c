@@ -0,0 +1,168 @@
+/*----------------------------------------------------------------------------
+  File    : stats_glm.c
+  Contents: mass-univariate general linear model (GLM) and
+            multivariate tests (Hotelling's T^2)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <float.h>
+#include "stats_glm.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define COV_BLKSIZE  16384      // max. number of values per block (cov())
+#define GLM_TILE     8          // number of columns per tile (glm_fit()
+                                // and glm_perm())
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static int chol (double *A, int p)
+{                               // --- Cholesky decomposition A = LL'
+  double tol = 0;               // (A: p x p, symmetric; L is stored
+  for (int i = 0; i < p; i++)   // in the lower triangle of A)
+    if (A[i*p+i] > tol) tol = A[i*p+i];
+  tol *= (double)p *DBL_EPSILON;  // tolerance for rank deficiency
+
+  for (int j = 0; j < p; j++) {
+    double d = A[j*p+j];
+    for (int k = 0; k < j; k++)
+      d -= A[j*p+k] * A[j*p+k];
+    if (!(d > tol)) return -1;  // check for positive definiteness
+    A[j*p+j] = d = sqrt(d);
+    for (int i = j+1; i < p; i++) {
+      double s = A[i*p+j];
+      for (int k = 0; k < j; k++)
+        s -= A[i*p+k] * A[j*p+k];
+      A[i*p+j] = s / d;
+    }
+  }
+  return 0;
+}  // chol()
+
+/*--------------------------------------------------------------------------*/
+
+static void cholsolve (const double *L, int p, double *b)
+{                               // --- solve LL'x = b (b is overwritten)
+  for (int i = 0; i < p; i++) { // forward substitution (Ly = b)
+    double s = b[i];
+    for (int k = 0; k < i; k++)
+      s -= L[i*p+k] * b[k];
+    b[i] = s / L[i*p+i];
+  }
+  for (int i = p-1; i >= 0; i--) {  // back substitution (L'x = y)
+    double s = b[i];
+    for (int k = i+1; k < p; k++)
+      s -= L[k*p+i] * b[k];
+    b[i] = s / L[i*p+i];
+  }
+}  // cholsolve()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL        float       // (re)define REAL to be float
+#define sqrt        sqrtf
+#define dot         sdot
+#define mean        smean
+#define glm         sglm
+#define glm_create  sglm_create
+#define glm_delete  sglm_delete
+#define glm_fit     sglm_fit
+#define glm_t       sglm_t
+#define glm_f       sglm_f
+#define glm_perm    sglm_perm
+#define glmjob      sglmjob
+#define tilefit     stilefit
+#define fittask     sfittask
+#define permtask    spermtask
+#define cov         scov
+#define hotelling1  shotelling1
+#define hotelling2  shotelling2
+#define hotelling2perm shotelling2perm
+#define hotjob      shotjob
+#define sscp        ssscp
+#define hottask     shottask
+#include "stats_glm_real.c"     // single precision versions
+#undef REAL
+#undef sqrt
+#undef dot
+#undef mean
+#undef glm
+#undef glm_create
+#undef glm_delete
+#undef glm_fit
+#undef glm_t
+#undef glm_f
+#undef glm_perm
+#undef glmjob
+#undef tilefit
+#undef fittask
+#undef permtask
+#undef cov
+#undef hotelling1
+#undef hotelling2
+#undef hotelling2perm
+#undef hotjob
+#undef sscp
+#undef hottask
+/*--------------------------------------------------------------------------*/
+#define REAL        double      // (re)define REAL to be double
+#define dot         ddot
+#define mean        dmean
+#define glm         dglm
+#define glm_create  dglm_create
+#define glm_delete  dglm_delete
+#define glm_fit     dglm_fit
+#define glm_t       dglm_t
+#define glm_f       dglm_f
+#define glm_perm    dglm_perm
+#define glmjob      dglmjob
+#define tilefit     dtilefit
+#define fittask     dfittask
+#define permtask    dpermtask
+#define cov         dcov
+#define hotelling1  dhotelling1
+#define hotelling2  dhotelling2
+#define hotelling2perm dhotelling2perm
+#define hotjob      dhotjob
+#define sscp        dsscp
+#define hottask     dhottask
+#include "stats_glm_real.c"     // double precision versions
+#undef REAL
+#undef dot
+#undef mean
+#undef glm
+#undef glm_create
+#undef glm_delete
+#undef glm_fit
+#undef glm_t
+#undef glm_f
+#undef glm_perm
+#undef glmjob
+#undef tilefit
+#undef fittask
+#undef permtask
+#undef cov
+#undef hotelling1
+#undef hotelling2
+#undef hotelling2perm
+#undef hotjob
+#undef sscp
+#undef hottask
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
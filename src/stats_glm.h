@@ -0,0 +1,257 @@
+/*----------------------------------------------------------------------------
+  File    : stats_glm.h
+  Contents: mass-univariate general linear model (GLM) and
+            multivariate tests (Hotelling's T^2)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_GLM_H
+#define STATS_GLM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "stats.h"
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct sglm {           // --- factored design (single precision)
+  int   n;                      // number of observations
+  int   p;                      // number of regressors
+  int   df;                     // residual degrees of freedom (n-p)
+  float *X;                     // design matrix (n x p, column-major)
+  float *pinv;                  // pseudo-inverse (X'X)^-1 X' (p x n,
+                                // row-major, i.e., one row per regressor)
+  float *xtxi;                  // (X'X)^-1 (p x p)
+} sglm;
+
+typedef struct dglm {           // --- factored design (double precision)
+  int    n;                     // number of observations
+  int    p;                     // number of regressors
+  int    df;                    // residual degrees of freedom (n-p)
+  double *X;                    // design matrix (n x p, column-major)
+  double *pinv;                 // pseudo-inverse (X'X)^-1 X' (p x n,
+                                // row-major, i.e., one row per regressor)
+  double *xtxi;                 // (X'X)^-1 (p x p)
+} dglm;
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+// All data matrices use the batched column-major layout, i.e., the n
+// observations of each of the nv voxels (columns) are stored contiguously.
+// The single and double precision versions are prefixed with s and d,
+// respectively (e.g., sglm_fit, dglm_fit).
+
+/* glm_create
+ * ----------
+ * factor a design matrix X (n x p, column-major, n > p)
+ *
+ * The factorization is computed in double precision (Cholesky
+ * decomposition of X'X) and is reused by all other glm_* functions.
+ *
+ * returns
+ * the factored design or NULL if X is rank-deficient or if memory
+ * allocation failed
+ */
+extern sglm*  sglm_create (const float  *X, int n, int p);
+extern dglm*  dglm_create (const double *X, int n, int p);
+
+/* glm_delete
+ * ----------
+ * delete a factored design
+ */
+extern void   sglm_delete (sglm *g);
+extern void   dglm_delete (dglm *g);
+
+/* glm_fit
+ * -------
+ * estimate the regression coefficients and the residual variances
+ *
+ * Y         data (n x nv)
+ * nv        number of voxels
+ * beta      buffer for the coefficients (p x nv)
+ * rv        buffer for the residual variances (nv) or NULL
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed
+ */
+extern int    sglm_fit    (const sglm *g, const float  *Y, int nv,
+                           float  *beta, float  *rv, int nthreads);
+extern int    dglm_fit    (const dglm *g, const double *Y, int nv,
+                           double *beta, double *rv, int nthreads);
+
+/* glm_t
+ * -----
+ * compute the t statistics for a contrast vector c (p)
+ *
+ * beta, rv  results of glm_fit
+ * t         buffer for the t statistics (nv)
+ */
+extern void   sglm_t      (const sglm *g, const float  *c,
+                           const float  *beta, const float  *rv, int nv,
+                           float  *t);
+extern void   dglm_t      (const dglm *g, const double *c,
+                           const double *beta, const double *rv, int nv,
+                           double *t);
+
+/* glm_f
+ * -----
+ * compute the F statistics for a contrast matrix C (q x p, row-major)
+ *
+ * beta, rv  results of glm_fit
+ * f         buffer for the F statistics (nv), df = (q, n-p)
+ *
+ * returns
+ * 0 on success, -1 if C is rank-deficient or memory allocation failed
+ */
+extern int    sglm_f      (const sglm *g, const float  *C, int q,
+                           const float  *beta, const float  *rv, int nv,
+                           float  *f);
+extern int    dglm_f      (const dglm *g, const double *C, int q,
+                           const double *beta, const double *rv, int nv,
+                           double *f);
+
+/* glm_perm
+ * --------
+ * permutation test of a t contrast (Freedman-Lane)
+ *
+ * The regressors with c[k] == 0 form the nuisance model. For each voxel,
+ * the residuals of the nuisance model are permuted and added back to its
+ * fitted values; the permuted data are then refitted with the (already
+ * factored) full model.
+ *
+ * Y         data (n x nv)
+ * c         contrast vector (p)
+ * prm       permutations (np x n, indices as for perm())
+ * np        number of permutations
+ * t         buffer for the t statistics (nv) or NULL
+ * pv        buffer for the p values (nv)
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * 0 on success, -1 if the nuisance model is rank-deficient or memory
+ * allocation failed
+ */
+extern int    sglm_perm   (const sglm *g, const float  *Y, int nv,
+                           const float  *c, const int *prm, int np,
+                           float  *t, float  *pv, int nthreads);
+extern int    dglm_perm   (const dglm *g, const double *Y, int nv,
+                           const double *c, const int *prm, int np,
+                           double *t, double *pv, int nthreads);
+
+/* cov
+ * ---
+ * covariance matrix of the p variables (columns) of X (n x p)
+ *
+ * The data are centered in blocks of rows that fit into the cache, and
+ * the cross-products of each block are accumulated (in double precision)
+ * from dot products of its columns.
+ *
+ * C         buffer for the covariance matrix (p x p)
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed
+ */
+extern int    scov        (const float  *X, int n, int p, float  *C);
+extern int    dcov        (const double *X, int n, int p, double *C);
+
+/* hotelling1, hotelling2
+ * ----------------------
+ * one- and two-sample Hotelling's T^2 test
+ *
+ * hotelling1 tests whether the mean of the rows of X (n x p, n > p)
+ * equals mu0 (p values; NULL -> zero vector), hotelling2 tests whether
+ * the means of the rows of X1 (n1 x p) and X2 (n2 x p, n1+n2 > p+1) are
+ * equal (pooled covariance matrix). The (pooled) covariance matrix is
+ * factored with a Cholesky decomposition.
+ *
+ * t2        buffer for T^2
+ * f         buffer for the equivalent F statistic or NULL
+ *           hotelling1: df = (p, n-p)
+ *           hotelling2: df = (p, n1+n2-p-1)
+ *
+ * returns
+ * 0 on success, -1 if the covariance matrix is singular or memory
+ * allocation failed
+ */
+extern int    shotelling1 (const float  *X, int n, int p,
+                           const float  *mu0, float  *t2, float  *f);
+extern int    dhotelling1 (const double *X, int n, int p,
+                           const double *mu0, double *t2, double *f);
+extern int    shotelling2 (const float  *X1, const float  *X2,
+                           int n1, int n2, int p, float  *t2, float  *f);
+extern int    dhotelling2 (const double *X1, const double *X2,
+                           int n1, int n2, int p, double *t2, double *f);
+
+/* hotelling2perm
+ * --------------
+ * permutation test for the two-sample Hotelling's T^2
+ *
+ * The total sums of cross-products T = W + c dd' (W: pooled within-group
+ * sums, d: mean difference, c = n1 n2/(n1+n2)) do not depend on the
+ * group labels. T is factored once (T = LL'), and the centered
+ * observations are whitened with L^-1. By the Sherman-Morrison formula,
+ * T^2 = (n1+n2-2) q/(1-q) with q = c d'T^-1 d = |g|^2/c, where g is the
+ * sum of the whitened observations in sample #1, so that each
+ * permutation only needs a sum of n1 vectors. As T^2 increases with q,
+ * the exceedances are counted by comparing |g|^2.
+ *
+ * X         data (n1+n2 x p, sample #1 in the first n1 rows)
+ * n         sizes of the samples (n[0] = n1, n[1] = n2)
+ * prm       permutations (np x (n1+n2), indices as for perm())
+ * np        number of permutations
+ * t2        buffer for T^2 or NULL
+ * pv        buffer for the p value
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * 0 on success, -1 if the covariance matrix is singular or memory
+ * allocation failed
+ */
+extern int    shotelling2perm (const float  *X, const int *n, int p,
+                               const int *prm, int np, float  *t2,
+                               float  *pv, int nthreads);
+extern int    dhotelling2perm (const double *X, const int *n, int p,
+                               const int *prm, int np, double *t2,
+                               double *pv, int nthreads);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define glm         dglm
+#    define glm_create  dglm_create
+#    define glm_delete  dglm_delete
+#    define glm_fit     dglm_fit
+#    define glm_t       dglm_t
+#    define glm_f       dglm_f
+#    define glm_perm    dglm_perm
+#    define cov         dcov
+#    define hotelling1  dhotelling1
+#    define hotelling2  dhotelling2
+#    define hotelling2perm dhotelling2perm
+#  else
+#    define glm         sglm
+#    define glm_create  sglm_create
+#    define glm_delete  sglm_delete
+#    define glm_fit     sglm_fit
+#    define glm_t       sglm_t
+#    define glm_f       sglm_f
+#    define glm_perm    sglm_perm
+#    define cov         scov
+#    define hotelling1  shotelling1
+#    define hotelling2  shotelling2
+#    define hotelling2perm shotelling2perm
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_GLM_H
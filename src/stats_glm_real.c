@@ -0,0 +1,559 @@
+/*----------------------------------------------------------------------------
+  File    : stats_glm_real.c
+  Contents: this file is to be included from stats_glm.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- job for the thread-parallel loops
+  const glm  *g;                // factored design (full model)
+  const glm  *gz;               // factored design (nuisance model)
+  const REAL *Y;                // data (n x nv)
+  REAL       *beta;             // coefficients (p x nv)
+  REAL       *rv;               // residual variances (nv)
+  const REAL *c;                // contrast vector (p)
+  REAL       cvc;               // c'(X'X)^-1 c
+  const int  *prm;              // permutations (np x n)
+  int        np;                // number of permutations
+  REAL       *t;                // t statistics (nv)
+  REAL       *pv;               // p values (nv)
+  int        err;               // error indicator
+} glmjob;
+
+typedef struct {                // --- job for the permutation test of
+  const REAL *Z;                //     Hotelling's T^2
+  int        p;                 // number of variables
+  int        n1;                // size of sample #1
+  int        ntotal;            // total number of observations
+  const int  *prm;              // permutations (np x ntotal)
+  REAL       q0;                // (observed statistic - tolerance)
+  int        *cnt;              // number of exceedances per thread
+  int        err;               // error indicator
+} hotjob;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void tilefit (const glm *g, const REAL *t, REAL *b, REAL *rss)
+{                               // --- fit a tile of GLM_TILE columns
+  enum { T = GLM_TILE };        // (value i of column c at t[i*T+c])
+  int n = g->n, p = g->p;
+  for (int k = 0; k < p; k++) { // B = (X'X)^-1 X'Y
+    const REAL *pk = g->pinv + (size_t)k*(size_t)n;
+    REAL acc[T];                // (each element of the pseudo-inverse
+    for (int c = 0; c < T; c++) // is used for all columns of the tile)
+      acc[c] = 0;
+    for (int i = 0; i < n; i++)
+      for (int c = 0; c < T; c++)
+        acc[c] += pk[i] * t[i*T+c];
+    for (int c = 0; c < T; c++)
+      b[k*T+c] = acc[c];
+  }
+  for (int c = 0; c < T; c++)   // residual sums of squares
+    rss[c] = 0;                 // (R = Y - XB, row by row)
+  for (int i = 0; i < n; i++) {
+    REAL r[T];
+    for (int c = 0; c < T; c++)
+      r[c] = t[i*T+c];
+    for (int k = 0; k < p; k++) {
+      REAL x = g->X[(size_t)k*(size_t)n + (size_t)i];
+      for (int c = 0; c < T; c++)
+        r[c] -= x * b[k*T+c];
+    }
+    for (int c = 0; c < T; c++)
+      rss[c] += r[c] * r[c];
+  }
+}  // tilefit()
+
+/*--------------------------------------------------------------------------*/
+
+static void fittask (void *data, int tid, int beg, int end)
+{                               // --- fit a range of voxels
+  enum { T = GLM_TILE };
+  glmjob *j = (glmjob*)data;
+  const glm *g = j->g;
+  int n = g->n, p = g->p;
+  REAL *t = (REAL*) malloc((size_t)(n+p)*T *sizeof(REAL));
+  if (!t) { j->err = -1; return; }
+  REAL *b = t + (size_t)n*T;    // coefficients of the tile (p x T)
+  REAL rss[T];                  // residual sums of squares
+
+  for (int v = beg; v < end; v += T) {
+    int m = (end-v < T) ? end-v : T;
+    for (int c = 0; c < T; c++) {   // gather a tile of voxels (the last
+      int w = v + ((c < m) ? c : m-1);  // one is padded with copies)
+      const REAL *y = j->Y + (size_t)w*(size_t)n;
+      for (int i = 0; i < n; i++)
+        t[i*T+c] = y[i];
+    }
+    tilefit(g, t, b, rss);
+    for (int c = 0; c < m; c++) {
+      REAL *bv = j->beta + (size_t)(v+c)*(size_t)p;
+      for (int k = 0; k < p; k++)
+        bv[k] = b[k*T+c];
+      if (j->rv) j->rv[v+c] = rss[c] /(REAL)g->df;
+    }
+  }
+  free(t);
+}  // fittask()
+
+/*--------------------------------------------------------------------------*/
+
+static void permtask (void *data, int tid, int beg, int end)
+{                               // --- permutation test (Freedman-Lane)
+  enum { T = GLM_TILE };
+  glmjob *j = (glmjob*)data;
+  const glm *g  = j->g;
+  const glm *gz = j->gz;
+  int n = g->n, p = g->p;
+  int q = gz ? gz->p : 0;
+  REAL *buf = (REAL*) malloc(((size_t)(n+p)*T + (size_t)(2*n + q))
+                             *sizeof(REAL));
+  if (!buf) { j->err = -1; return; }
+  REAL *t  = buf;               // tile of permuted data (n x T)
+  REAL *b  = t  + (size_t)n*T;  // coefficients of the tile (p x T)
+  REAL *yz = b  + (size_t)p*T;  // fitted values of the nuisance model
+  REAL *ez = yz + n;            // residuals of the nuisance model
+  REAL *bz = ez + n;            // coefficients of the nuisance model
+  REAL rss[T], ts[T];           // residual sums of squares, statistics
+
+  for (int v = beg; v < end; v++) {
+    const REAL *y = j->Y + (size_t)v*(size_t)n;
+
+    // split the data into fitted values and residuals (nuisance model)
+    for (int i = 0; i < n; i++)
+      yz[i] = 0;
+    for (int k = 0; k < q; k++) {
+      bz[k] = dot(gz->pinv + (size_t)k*(size_t)n, y, n);
+      const REAL *x = gz->X + (size_t)k*(size_t)n;
+      for (int i = 0; i < n; i++)
+        yz[i] += bz[k] * x[i];
+    }
+    for (int i = 0; i < n; i++)
+      ez[i] = y[i] - yz[i];
+
+    // refit the permuted data with the full model, GLM_TILE
+    // permutations at a time (tile -T: observed statistic)
+    REAL t0 = 0;
+    int cnt = 0;
+    for (int i = -T; i < j->np; i += T) {
+      if (i < 0) {              // observed data (no permutation)
+        for (int l = 0; l < n; l++)
+          for (int c = 0; c < T; c++)
+            t[l*T+c] = y[l];
+      }
+      else {                    // gather a tile of permuted data (the
+        for (int c = 0; c < T; c++) {   // last one is padded with copies)
+          int k = (i+c < j->np) ? i+c : j->np-1;
+          const int *pi = j->prm + (size_t)k*(size_t)n;
+          for (int l = 0; l < n; l++)
+            t[l*T+c] = yz[l] + ez[pi[l]];
+        }
+      }
+      tilefit(g, t, b, rss);
+      for (int c = 0; c < T; c++) {
+        REAL s = 0;             // t = c'b / sqrt(rv c'(X'X)^-1 c)
+        for (int k = 0; k < p; k++)
+          s += j->c[k] * b[k*T+c];
+        ts[c] = s / sqrt(rss[c] /(REAL)g->df * j->cvc);
+      }
+      if (i < 0) { t0 = ts[0]; continue; }
+      for (int c = 0; (c < T) && (i+c < j->np); c++)
+        cnt += (fabs(ts[c]) >= fabs(t0));
+    }
+    if (j->t) j->t[v] = t0;
+    j->pv[v] = (REAL)(cnt + 1)/(REAL)(j->np + 1);
+  }
+  free(buf);
+}  // permtask()
+
+/*--------------------------------------------------------------------------*/
+
+static int sscp (const REAL *X, int n, int p, double *S, REAL *mu)
+{                               // --- centered sums of cross-products
+  int nb = COV_BLKSIZE / p;     // number of rows per block (so that the
+  if (nb < 16) nb = 16;         // centered block stays in the cache)
+  if (nb > n)  nb = n;
+  REAL *buf = (REAL*) malloc((size_t)nb*(size_t)p *sizeof(REAL));
+  if (!buf) return -1;
+
+  for (int k = 0; k < p; k++)
+    mu[k] = mean(X + (size_t)k*(size_t)n, n);
+  for (int k = 0; k < p*p; k++)
+    S[k] = 0;
+  for (int r = 0; r < n; r += nb) {
+    int m = (n-r < nb) ? n-r : nb;
+    for (int k = 0; k < p; k++) {   // center a block of rows
+      const REAL *x = X + (size_t)k*(size_t)n + (size_t)r;
+      REAL *b = buf + (size_t)k*(size_t)m;
+      for (int i = 0; i < m; i++)
+        b[i] = x[i] - mu[k];
+    }
+    for (int k = 0; k < p; k++) {   // accumulate the lower triangle of
+      const REAL *bk = buf + (size_t)k*(size_t)m;   // the block's
+      for (int l = 0; l <= k; l++)                  // cross-products
+        S[k*p+l] += (double)dot(bk, buf + (size_t)l*(size_t)m, m);
+    }
+  }
+  for (int k = 0; k < p; k++)
+    for (int l = 0; l < k; l++)
+      S[l*p+k] = S[k*p+l];
+  free(buf);
+  return 0;
+}  // sscp()
+
+/*--------------------------------------------------------------------------*/
+
+static void hottask (void *data, int tid, int beg, int end)
+{                               // --- count the exceedances of T^2
+  hotjob *j = (hotjob*)data;    // for a range of permutations
+  int p = j->p, n1 = j->n1;
+  REAL *g = (REAL*) malloc((size_t)p *sizeof(REAL));
+  if (!g) { j->err = -1; return; }
+
+  int cnt = 0;
+  for (int i = beg; i < end; i++) {
+    const int *pi = j->prm + (size_t)i*(size_t)j->ntotal;
+    for (int k = 0; k < p; k++) // sum of the whitened observations
+      g[k] = 0;                 // in (permuted) sample #1
+    for (int l = 0; l < n1; l++) {
+      const REAL *z = j->Z + (size_t)pi[l]*(size_t)p;
+      for (int k = 0; k < p; k++)
+        g[k] += z[k];
+    }
+    cnt += (dot(g, g, p) >= j->q0);
+  }
+  j->cnt[tid] += cnt;
+  free(g);
+}  // hottask()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+glm* glm_create (const REAL *X, int n, int p)
+{
+  assert(X && (p > 0) && (n > p));
+
+  size_t np = (size_t)n*(size_t)p;
+  glm    *g = (glm*)    malloc(sizeof(glm));
+  REAL   *m = (REAL*)   malloc((2*np + (size_t)(p*p)) *sizeof(REAL));
+  double *A = (double*) malloc((size_t)(2*p*p) *sizeof(double));
+  if (!g || !m || !A) {
+    free(g); free(m); free(A); return NULL; }
+  g->n = n; g->p = p; g->df = n-p;
+  g->X    = m;
+  g->pinv = m + np;
+  g->xtxi = m + 2*np;
+  for (size_t i = 0; i < np; i++)
+    g->X[i] = X[i];
+
+  // compute and factor X'X
+  double *xtxi = A + p*p;
+  for (int k = 0; k < p; k++) {
+    for (int l = 0; l <= k; l++) {
+      const REAL *xk = X + (size_t)k*(size_t)n;
+      const REAL *xl = X + (size_t)l*(size_t)n;
+      double s = 0;
+      for (int i = 0; i < n; i++)
+        s += (double)xk[i] * (double)xl[i];
+      A[k*p+l] = A[l*p+k] = s;
+    }
+  }
+  if (chol(A, p) != 0) {        // if X'X is not positive definite,
+    free(A); glm_delete(g);     // the design is rank-deficient
+    return NULL;
+  }
+
+  // compute (X'X)^-1 column by column
+  for (int k = 0; k < p; k++) {
+    double *e = xtxi + k*p;
+    for (int l = 0; l < p; l++)
+      e[l] = (l == k) ? 1 : 0;
+    cholsolve(A, p, e);
+  }
+  for (int k = 0; k < p*p; k++)
+    g->xtxi[k] = (REAL)xtxi[k];
+
+  // compute the pseudo-inverse (X'X)^-1 X'
+  for (int k = 0; k < p; k++) {
+    for (int i = 0; i < n; i++) {
+      double s = 0;
+      for (int l = 0; l < p; l++)
+        s += xtxi[k*p+l] * (double)X[(size_t)l*(size_t)n + (size_t)i];
+      g->pinv[(size_t)k*(size_t)n + (size_t)i] = (REAL)s;
+    }
+  }
+  free(A);
+  return g;
+}  // glm_create()
+
+/*--------------------------------------------------------------------------*/
+
+void glm_delete (glm *g)
+{
+  if (!g) return;
+  free(g->X);                   // (X, pinv, and xtxi are one block)
+  free(g);
+}  // glm_delete()
+
+/*--------------------------------------------------------------------------*/
+
+int glm_fit (const glm *g, const REAL *Y, int nv,
+             REAL *beta, REAL *rv, int nthreads)
+{
+  assert(g && Y && (nv > 0) && beta);
+
+  glmjob j = { .g = g, .Y = Y, .beta = beta, .rv = rv, .err = 0 };
+  stats_parfor(nthreads, nv, fittask, &j);
+  return j.err;
+}  // glm_fit()
+
+/*--------------------------------------------------------------------------*/
+
+void glm_t (const glm *g, const REAL *c,
+            const REAL *beta, const REAL *rv, int nv, REAL *t)
+{
+  assert(g && c && beta && rv && (nv > 0) && t);
+
+  int p = g->p;
+  REAL cvc = 0;                 // compute c'(X'X)^-1 c
+  for (int k = 0; k < p; k++)
+    for (int l = 0; l < p; l++)
+      cvc += c[k] * g->xtxi[k*p+l] * c[l];
+
+  for (int v = 0; v < nv; v++)
+    t[v] = dot(c, beta + (size_t)v*(size_t)p, p) / sqrt(rv[v] * cvc);
+}  // glm_t()
+
+/*--------------------------------------------------------------------------*/
+
+int glm_f (const glm *g, const REAL *C, int q,
+           const REAL *beta, const REAL *rv, int nv, REAL *f)
+{
+  assert(g && C && (q > 0) && (q <= g->p) && beta && rv && (nv > 0) && f);
+
+  int p = g->p;
+  double *M = (double*) malloc((size_t)(q*q + q*p + q) *sizeof(double));
+  if (!M) return -1;
+  double *CV = M  + q*q;        // C(X'X)^-1
+  double *d  = CV + q*p;        // C beta
+
+  // compute and factor C(X'X)^-1 C'
+  for (int a = 0; a < q; a++)
+    for (int k = 0; k < p; k++) {
+      double s = 0;
+      for (int l = 0; l < p; l++)
+        s += (double)C[a*p+l] * (double)g->xtxi[l*p+k];
+      CV[a*p+k] = s;
+    }
+  for (int a = 0; a < q; a++)
+    for (int b = 0; b < q; b++) {
+      double s = 0;
+      for (int k = 0; k < p; k++)
+        s += CV[a*p+k] * (double)C[b*p+k];
+      M[a*q+b] = s;
+    }
+  if (chol(M, q) != 0) {
+    free(M); return -1; }
+
+  // F = (C beta)' (C(X'X)^-1 C')^-1 (C beta) / (q rv)
+  double *x = CV;               // (reuse CV as a buffer)
+  for (int v = 0; v < nv; v++) {
+    const REAL *b = beta + (size_t)v*(size_t)p;
+    for (int a = 0; a < q; a++)
+      x[a] = d[a] = (double)dot(C + a*p, b, p);
+    cholsolve(M, q, x);
+    double s = 0;
+    for (int a = 0; a < q; a++)
+      s += d[a] * x[a];
+    f[v] = (REAL)(s / ((double)q * (double)rv[v]));
+  }
+  free(M);
+  return 0;
+}  // glm_f()
+
+/*--------------------------------------------------------------------------*/
+
+int glm_perm (const glm *g, const REAL *Y, int nv,
+              const REAL *c, const int *prm, int np,
+              REAL *t, REAL *pv, int nthreads)
+{
+  assert(g && Y && (nv > 0) && c && prm && (np > 0) && pv);
+
+  int n = g->n, p = g->p;
+
+  // factor the nuisance model (regressors not involved in the contrast)
+  glm *gz = NULL;
+  int q = 0;
+  for (int k = 0; k < p; k++)
+    q += (c[k] == 0);
+  if (q > 0) {
+    REAL *Z = (REAL*) malloc((size_t)n*(size_t)q *sizeof(REAL));
+    if (!Z) return -1;
+    for (int k = 0, l = 0; k < p; k++) {
+      if (c[k] != 0) continue;
+      const REAL *x = g->X + (size_t)k*(size_t)n;
+      REAL *z = Z + (size_t)(l++)*(size_t)n;
+      for (int i = 0; i < n; i++)
+        z[i] = x[i];
+    }
+    gz = glm_create(Z, n, q);
+    free(Z);
+    if (!gz) return -1;
+  }
+
+  glmjob j = { .g = g, .gz = gz, .Y = Y, .c = c, .cvc = 0,
+               .prm = prm, .np = np, .t = t, .pv = pv, .err = 0 };
+  for (int k = 0; k < p; k++)   // compute c'(X'X)^-1 c
+    for (int l = 0; l < p; l++)
+      j.cvc += c[k] * g->xtxi[k*p+l] * c[l];
+  stats_parfor(nthreads, nv, permtask, &j);
+
+  glm_delete(gz);
+  return j.err;
+}  // glm_perm()
+
+/*--------------------------------------------------------------------------*/
+
+int cov (const REAL *X, int n, int p, REAL *C)
+{
+  assert(X && (n > 1) && (p > 0) && C);
+
+  double *S  = (double*) malloc((size_t)(p*p) *sizeof(double));
+  REAL   *mu = (REAL*)   malloc((size_t)p *sizeof(REAL));
+  if (!S || !mu || (sscp(X, n, p, S, mu) != 0)) {
+    free(S); free(mu); return -1; }
+  for (int k = 0; k < p*p; k++)
+    C[k] = (REAL)(S[k] / (double)(n-1));
+  free(S); free(mu);
+  return 0;
+}  // cov()
+
+/*--------------------------------------------------------------------------*/
+
+int hotelling1 (const REAL *X, int n, int p, const REAL *mu0,
+                REAL *t2, REAL *f)
+{
+  assert(X && (p > 0) && (n > p) && t2);
+
+  double *S  = (double*) malloc((size_t)(p*p + 2*p) *sizeof(double));
+  REAL   *mu = (REAL*)   malloc((size_t)p *sizeof(REAL));
+  if (!S || !mu || (sscp(X, n, p, S, mu) != 0) || (chol(S, p) != 0)) {
+    free(S); free(mu); return -1; }
+  double *d = S + p*p, *x = d + p;
+
+  // T^2 = n d' S^-1 d with d = mean - mu0 and S = SSCP/(n-1)
+  for (int k = 0; k < p; k++)
+    x[k] = d[k] = (double)mu[k] - (mu0 ? (double)mu0[k] : 0);
+  cholsolve(S, p, x);
+  double u = 0;
+  for (int k = 0; k < p; k++)
+    u += d[k] * x[k];
+  double t = (double)n * (double)(n-1) * u;
+  *t2 = (REAL)t;
+  if (f) *f = (REAL)(t * (double)(n-p) / ((double)p * (double)(n-1)));
+  free(S); free(mu);
+  return 0;
+}  // hotelling1()
+
+/*--------------------------------------------------------------------------*/
+
+int hotelling2 (const REAL *X1, const REAL *X2, int n1, int n2, int p,
+                REAL *t2, REAL *f)
+{
+  assert(X1 && X2 && (n1 > 0) && (n2 > 0) && (p > 0) && (n1+n2 > p+1)
+      && t2);
+
+  double *S  = (double*) malloc((size_t)(2*p*p + 2*p) *sizeof(double));
+  REAL   *mu = (REAL*)   malloc((size_t)(2*p) *sizeof(REAL));
+  if (!S || !mu) {
+    free(S); free(mu); return -1; }
+  double *S2 = S + p*p, *d = S2 + p*p, *x = d + p;
+  int err = sscp(X1, n1, p, S,  mu)   // compute and factor
+          | sscp(X2, n2, p, S2, mu+p);  // the pooled SSCP matrix
+  for (int k = 0; k < p*p; k++)
+    S[k] += S2[k];
+  if (err || (chol(S, p) != 0)) {
+    free(S); free(mu); return -1; }
+
+  // T^2 = n1 n2/(n1+n2) d' Sp^-1 d with Sp = SSCP/(n1+n2-2)
+  for (int k = 0; k < p; k++)
+    x[k] = d[k] = (double)mu[k] - (double)mu[p+k];
+  cholsolve(S, p, x);
+  double u = 0;
+  for (int k = 0; k < p; k++)
+    u += d[k] * x[k];
+  double nt = (double)(n1+n2);
+  double t  = (double)n1 * (double)n2 / nt * (nt-2) * u;
+  *t2 = (REAL)t;
+  if (f) *f = (REAL)(t * (nt-(double)p-1) / ((double)p * (nt-2)));
+  free(S); free(mu);
+  return 0;
+}  // hotelling2()
+
+/*--------------------------------------------------------------------------*/
+
+int hotelling2perm (const REAL *X, const int *n, int p,
+                    const int *prm, int np, REAL *t2, REAL *pv,
+                    int nthreads)
+{
+  assert(X && n && (n[0] > 0) && (n[1] > 0) && (p > 0)
+      && (n[0]+n[1] > p+1) && prm && (np > 0) && pv);
+
+  int n1 = n[0], nt = n[0]+n[1];
+  int nth = stats_nthreads(nthreads);
+  double *L  = (double*) malloc((size_t)(p*p + p) *sizeof(double));
+  REAL   *Z  = (REAL*)   malloc(((size_t)nt+1)*(size_t)p *sizeof(REAL));
+  int    *cs = (int*)    calloc((size_t)nth, sizeof(int));
+  if (!L || !Z || !cs) {
+    free(L); free(Z); free(cs); return -1; }
+  double *v  = L + p*p;
+  REAL   *mu = Z + (size_t)nt*(size_t)p;
+  if ((sscp(X, nt, p, L, mu) != 0) || (chol(L, p) != 0)) {
+    free(L); free(Z); free(cs); return -1; }
+
+  // whiten the centered observations: z_i = L^-1 (x_i - mean)
+  for (int i = 0; i < nt; i++) {
+    REAL *z = Z + (size_t)i*(size_t)p;
+    for (int k = 0; k < p; k++) {
+      double s = (double)X[(size_t)k*(size_t)nt + (size_t)i]
+               - (double)mu[k];
+      for (int l = 0; l < k; l++)
+        s -= L[k*p+l] * v[l];
+      v[k] = s / L[k*p+k];
+    }
+    for (int k = 0; k < p; k++)
+      z[k] = (REAL)v[k];
+  }
+
+  // observed statistic: q = |g|^2/c, T^2 = (n1+n2-2) q/(1-q)
+  hotjob j = { .Z = Z, .p = p, .n1 = n1, .ntotal = nt, .q0 = 0,
+               .cnt = cs, .err = 0 };
+  REAL *g = (REAL*)v;           // (v is no longer needed)
+  for (int k = 0; k < p; k++)
+    g[k] = 0;
+  for (int l = 0; l < n1; l++)
+    for (int k = 0; k < p; k++)
+      g[k] += Z[(size_t)l*(size_t)p + (size_t)k];
+  REAL   q0 = dot(g, g, p);
+  double c  = (double)n1 * (double)n[1] / (double)nt;
+  double q  = (double)q0 / c;
+  if (t2) *t2 = (REAL)((double)(nt-2) * q / (1-q));
+  REAL eps = (REAL)(4*nt) * ((sizeof(REAL) == sizeof(float))
+           ? (REAL)FLT_EPSILON : (REAL)DBL_EPSILON);
+  j.q0 = q0 * (1 - eps);        // (ties within the rounding error)
+
+  // count the permutations with a statistic at least as large
+  j.prm = prm;
+  stats_parfor(nthreads, np, hottask, &j);
+  int cnt = 0;
+  for (int i = 0; i < nth; i++)
+    cnt += cs[i];
+  *pv = (REAL)(cnt + 1)/(REAL)(np + 1);
+  free(L); free(Z); free(cs);
+  return j.err;
+}  // hotelling2perm()
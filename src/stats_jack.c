@@ -0,0 +1,69 @@
+/*----------------------------------------------------------------------------
+  File    : stats_jack.c
+  Contents: jackknife (leave-one-out) statistics
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include "stats_jack.h"
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define sqrt      sqrtf
+#define jkmean    sjkmean
+#define jkvar     sjkvar
+#define jktstat   sjktstat
+#define jkmdiff   sjkmdiff
+#define jktstat2  sjktstat2
+#define jkpairedt sjkpairedt
+#define jack      sjack
+#define jkt       sjkt
+#include "def-or-undef-functions.inc"
+#include "stats_jack_real.c"    // single precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef sqrt
+#undef jkmean
+#undef jkvar
+#undef jktstat
+#undef jkmdiff
+#undef jktstat2
+#undef jkpairedt
+#undef jack
+#undef jkt
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define jkmean    djkmean
+#define jkvar     djkvar
+#define jktstat   djktstat
+#define jkmdiff   djkmdiff
+#define jktstat2  djktstat2
+#define jkpairedt djkpairedt
+#define jack      djack
+#define jkt       djkt
+#include "def-or-undef-functions.inc"
+#include "stats_jack_real.c"    // double precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef jkmean
+#undef jkvar
+#undef jktstat
+#undef jkmdiff
+#undef jktstat2
+#undef jkpairedt
+#undef jack
+#undef jkt
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------------
+  File    : stats_jack.h
+  Contents: jackknife (leave-one-out) statistics
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_JACK_H
+#define STATS_JACK_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "stats.h"
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* jkmean, jkvar, jktstat
+ * ----------------------
+ * compute the n leave-one-out means, variances or t statistics
+ *
+ * The sum and the sum of squared deviations from the mean (M2) are
+ * computed once; the value without a[i] is then obtained in O(1) by
+ * downdating them: m_i = m - d_i/(n-1) and M2_i = M2 - d_i^2 n/(n-1)
+ * with d_i = a[i] - m. The loops over the outputs are branch-free and
+ * vectorized by the compiler. (M2_i is clamped at 0 to guard against
+ * cancellation if a[i] accounts for almost all of M2.)
+ *
+ * a      data (n values; n > 1 for jkmean, n > 2 otherwise)
+ * r      buffer for the n results (r[i]: statistic without a[i])
+ */
+extern void sjkmean   (const float  *a, int n, float  *r);
+extern void djkmean   (const double *a, int n, double *r);
+extern void sjkvar    (const float  *a, int n, float  *r);
+extern void djkvar    (const double *a, int n, double *r);
+extern void sjktstat  (const float  *a, int n, float  *r);
+extern void djktstat  (const double *a, int n, double *r);
+
+/* jkmdiff, jktstat2, jkpairedt
+ * ----------------------------
+ * compute the leave-one-out mean differences, two-sample t statistics
+ * or paired t statistics (downdating as for jkmean, jkvar and jktstat)
+ *
+ * x1, x2  data of sample #1 and #2
+ * n1, n2  sizes of the samples (jkpairedt: n pairs)
+ * r       buffer for the n1+n2 (jkpairedt: n) results; r[i] is the
+ *         statistic without x1[i] and r[n1+i] the one without x2[i]
+ *         (jkpairedt: r[i] is the statistic without the pair i)
+ */
+extern void sjkmdiff  (const float  *x1, const float  *x2, int n1, int n2,
+                       float  *r);
+extern void djkmdiff  (const double *x1, const double *x2, int n1, int n2,
+                       double *r);
+extern void sjktstat2 (const float  *x1, const float  *x2, int n1, int n2,
+                       float  *r);
+extern void djktstat2 (const double *x1, const double *x2, int n1, int n2,
+                       double *r);
+extern void sjkpairedt(const float  *x1, const float  *x2, int n,
+                       float  *r);
+extern void djkpairedt(const double *x1, const double *x2, int n,
+                       double *r);
+
+/* jack
+ * ----
+ * jackknife estimates of the bias and the standard error of a statistic
+ *
+ * The statistic is recomputed without each unit (a value, or a pair for
+ * blk = 2) of each stratum in turn. For mean_w, var_w, std_w and tstat_w
+ * (ns = 1, blk = 1), mdiff_w and tstat2_w (ns = 2, blk = 1) and pairedt_w
+ * (ns = 1, blk = 2), the leave-one-out values are obtained by downdating
+ * (see above) in O(N) in total, where N is the number of units. For other
+ * statistics, the data without the unit are copied and func is called
+ * N times (O(N^2)).
+ *
+ * a, n, ns, blk, func  data, sizes of the strata, number of strata,
+ *                      number of blocks, statistic (as for boot())
+ * loo       buffer for the N leave-one-out values, or NULL
+ * bias      where to store the bias estimate (N-1)(mean(loo) - theta),
+ *           or NULL
+ * se        where to store the standard error
+ *           sqrt((N-1)/N sum (loo - mean(loo))^2), or NULL
+ *
+ * returns
+ * the statistic theta computed on all data; NaN if memory allocation
+ * failed
+ */
+extern float  sjack   (const float  *a, const int *n, int ns, int blk,
+                       Func1s *func, float  *loo, float  *bias,
+                       float  *se);
+extern double djack   (const double *a, const int *n, int ns, int blk,
+                       Func1d *func, double *loo, double *bias,
+                       double *se);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define jkmean    djkmean
+#    define jkvar     djkvar
+#    define jktstat   djktstat
+#    define jkmdiff   djkmdiff
+#    define jktstat2  djktstat2
+#    define jkpairedt djkpairedt
+#    define jack      djack
+#  else
+#    define jkmean    sjkmean
+#    define jkvar     sjkvar
+#    define jktstat   sjktstat
+#    define jkmdiff   sjkmdiff
+#    define jktstat2  sjktstat2
+#    define jkpairedt sjkpairedt
+#    define jack      sjack
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_JACK_H
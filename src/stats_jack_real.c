@@ -0,0 +1,189 @@
+/*----------------------------------------------------------------------------
+  File    : stats_jack_real.c
+  Contents: this file is to be included from stats_jack.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void jkt (const REAL *a, int n, REAL m, REAL m2, REAL *r)
+{                               // --- leave-one-out t statistics
+  REAL g = 1/(REAL)(n-1);       //     (m: mean, m2: M2; r may be a)
+  REAL f = (REAL)n * g;
+  REAL h = g / (REAL)(n-2);     // var_i/(n-1) = M2_i/((n-2)(n-1))
+  for (int i = 0; i < n; i++) {
+    REAL d = a[i] - m;
+    REAL q = m2 - f*d*d;
+    q    = (q > 0) ? q : 0;
+    r[i] = (m - d*g) / sqrt(q*h);
+  }
+}  // jkt()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+void jkmean (const REAL *a, int n, REAL *r)
+{
+  assert(a && (n > 1) && r);
+
+  REAL s = sum(a, n);
+  REAL g = 1/(REAL)(n-1);
+  for (int i = 0; i < n; i++)
+    r[i] = (s - a[i]) * g;
+}  // jkmean()
+
+/*--------------------------------------------------------------------------*/
+
+void jkvar (const REAL *a, int n, REAL *r)
+{
+  assert(a && (n > 2) && r);
+
+  REAL m  = mean(a, n);
+  REAL m2 = varm(a, n, m) * (REAL)(n-1);
+  REAL f  = (REAL)n / (REAL)(n-1);
+  REAL h  = 1/(REAL)(n-2);
+  for (int i = 0; i < n; i++) {
+    REAL d = a[i] - m;
+    REAL q = m2 - f*d*d;
+    r[i] = ((q > 0) ? q : 0) * h;
+  }
+}  // jkvar()
+
+/*--------------------------------------------------------------------------*/
+
+void jktstat (const REAL *a, int n, REAL *r)
+{
+  assert(a && (n > 2) && r);
+
+  REAL m = mean(a, n);
+  jkt(a, n, m, varm(a, n, m) * (REAL)(n-1), r);
+}  // jktstat()
+
+/*--------------------------------------------------------------------------*/
+
+void jkmdiff (const REAL *x1, const REAL *x2, int n1, int n2, REAL *r)
+{
+  assert(x1 && x2 && (n1 > 1) && (n2 > 1) && r);
+
+  REAL m1 = mean(x1, n1), g1 = 1/(REAL)(n1-1);
+  REAL m2 = mean(x2, n2), g2 = 1/(REAL)(n2-1);
+  for (int i = 0; i < n1; i++)
+    r[i]    = (m1 - (x1[i] - m1)*g1) - m2;
+  for (int i = 0; i < n2; i++)
+    r[n1+i] = m1 - (m2 - (x2[i] - m2)*g2);
+}  // jkmdiff()
+
+/*--------------------------------------------------------------------------*/
+
+void jktstat2 (const REAL *x1, const REAL *x2, int n1, int n2, REAL *r)
+{
+  assert(x1 && x2 && (n1 > 1) && (n2 > 1) && (n1+n2 > 3) && r);
+
+  REAL m1 = mean(x1, n1), q1 = varm(x1, n1, m1) * (REAL)(n1-1);
+  REAL m2 = mean(x2, n2), q2 = varm(x2, n2, m2) * (REAL)(n2-1);
+  REAL df = (REAL)(n1+n2-3);    // degrees of freedom without one value
+  REAL g1 = 1/(REAL)(n1-1), f1 = (REAL)n1 * g1;
+  REAL g2 = 1/(REAL)(n2-1), f2 = (REAL)n2 * g2;
+  REAL c1 = sqrt(g1 + 1/(REAL)n2);  // sqrt(1/n1' + 1/n2')
+  REAL c2 = sqrt(1/(REAL)n1 + g2);
+  for (int i = 0; i < n1; i++) {    // without x1[i]
+    REAL d = x1[i] - m1;
+    REAL q = q1 - f1*d*d;
+    q = ((q > 0) ? q : 0) + q2;
+    r[i] = ((m1 - d*g1) - m2) / (sqrt(q/df) * c1);
+  }
+  for (int i = 0; i < n2; i++) {    // without x2[i]
+    REAL d = x2[i] - m2;
+    REAL q = q2 - f2*d*d;
+    q = ((q > 0) ? q : 0) + q1;
+    r[n1+i] = (m1 - (m2 - d*g2)) / (sqrt(q/df) * c2);
+  }
+}  // jktstat2()
+
+/*--------------------------------------------------------------------------*/
+
+void jkpairedt (const REAL *x1, const REAL *x2, int n, REAL *r)
+{
+  assert(x1 && x2 && (n > 2) && r);
+
+  for (int i = 0; i < n; i++)   // differences (in the result buffer)
+    r[i] = x1[i] - x2[i];
+  REAL m = mean(r, n);
+  jkt(r, n, m, varm(r, n, m) * (REAL)(n-1), r);
+}  // jkpairedt()
+
+/*--------------------------------------------------------------------------*/
+
+REAL jack (const REAL *a, const int *n, int ns, int blk, Func1 *func,
+           REAL *loo, REAL *bias, REAL *se)
+{
+  assert(a && n && (ns > 0) && (blk > 0) && func);
+
+  int nu = 0, nv = 0;           // number of units and values
+  for (int s = 0; s < ns; s++) {
+    nu += n[s]; nv += blk*n[s]; }
+  REAL theta = func(a, n);      // statistic of all data
+  REAL *r = loo;
+  if (!r && !(r = (REAL*) malloc((size_t)nu *sizeof(REAL))))
+    return (REAL)NAN;
+
+  // compute the leave-one-out values (downdating, if possible)
+  int n0 = n[0], n1 = (ns > 1) ? n[1] : 0;
+  if      ((ns == 1) && (blk == 1) && (func == mean_w) && (n0 > 1))
+    jkmean(a, n0, r);
+  else if ((ns == 1) && (blk == 1) && (func == var_w) && (n0 > 2))
+    jkvar(a, n0, r);
+  else if ((ns == 1) && (blk == 1) && (func == std_w) && (n0 > 2)) {
+    jkvar(a, n0, r);
+    for (int i = 0; i < n0; i++)
+      r[i] = sqrt(r[i]);
+  }
+  else if ((ns == 1) && (blk == 1) && (func == tstat_w) && (n0 > 2))
+    jktstat(a, n0, r);
+  else if ((ns == 2) && (blk == 1) && (func == mdiff_w)
+       &&  (n0 > 1) && (n1 > 1))
+    jkmdiff(a, a+n0, n0, n1, r);
+  else if ((ns == 2) && (blk == 1) && (func == tstat2_w)
+       &&  (n0 > 1) && (n1 > 1) && (n0+n1 > 3))
+    jktstat2(a, a+n0, n0, n1, r);
+  else if ((ns == 1) && (blk == 2) && (func == pairedt_w) && (n0 > 2))
+    jkpairedt(a, a+n0, n0, r);
+  else {                        // copy the data without each unit
+    REAL *tmp = (REAL*) malloc((size_t)nv *sizeof(REAL)
+                             + (size_t)ns *sizeof(int));
+    if (!tmp) {
+      if (!loo) free(r);
+      return (REAL)NAN;
+    }
+    int *nj = (int*)(tmp + nv);
+    for (int s = 0; s < ns; s++)
+      nj[s] = n[s];
+    for (int st = 0, u = 0; st < ns; st++) {
+      nj[st] = n[st]-1;
+      for (int i = 0; i < n[st]; i++, u++) {
+        for (int t = 0, p = 0, q = 0; t < ns; t++)
+          for (int c = 0; c < blk; c++)
+            for (int l = 0; l < n[t]; l++, q++)
+              if ((t != st) || (l != i)) tmp[p++] = a[q];
+        r[u] = func(tmp, nj);
+      }
+      nj[st] = n[st];
+    }
+    free(tmp);
+  }
+
+  // compute the bias and the standard error
+  double m = 0, v = 0;
+  for (int u = 0; u < nu; u++)
+    m += (double)r[u];
+  m /= (double)nu;
+  for (int u = 0; u < nu; u++)
+    v += ((double)r[u] - m) * ((double)r[u] - m);
+  if (bias) *bias = (REAL)((double)(nu-1) * (m - (double)theta));
+  if (se)   *se   = sqrt((REAL)((double)(nu-1) / (double)nu * v));
+  if (!loo) free(r);
+  return theta;
+}  // jack()
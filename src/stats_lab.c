@@ -0,0 +1,132 @@
+/*----------------------------------------------------------------------------
+  File    : stats_lab.c
+  Contents: group statistics and tests based on label vectors
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include "stats_lab.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static int labcnt (const unsigned char *lab, int n, int k, int *cnt)
+{                               // --- count the values of each group
+  for (int g = 0; g < LAB_MAXK; g++)
+    cnt[g] = 0;
+  for (int i = 0; i < n; i++)
+    cnt[lab[i]]++;
+  for (int g = k; g < LAB_MAXK; g++)
+    if (cnt[g] > 0) return -1;  // (labels >= k are invalid)
+  return 0;
+}  // labcnt()
+
+/*--------------------------------------------------------------------------*/
+
+static double labval (int test, const int *cnt, int k,
+                      const double *s, const double *q, int cmp)
+{                               // --- statistic or value to compare
+  double n0 = (double)cnt[0], n1 = (double)cnt[1];
+  double st = 0, qt = 0;        // (s and q of the centered data)
+  switch (test) {
+    case LAB_MDIFF:
+    case LAB_T2:                // |t| is monotone in |s[1]|
+      if (cmp) return fabs(s[1]);
+      if (test == LAB_MDIFF) return s[0]/n0 - s[1]/n1;
+      return (s[0]/n0 - s[1]/n1)
+           / sqrt((q[0] - s[0]*s[0]/n0 + q[1] - s[1]*s[1]/n1)
+                  / (n0+n1-2) * (1/n0 + 1/n1));
+    case LAB_WELCH: {
+      double a0 = (q[0] - s[0]*s[0]/n0) / (n0-1) / n0;
+      double a1 = (q[1] - s[1]*s[1]/n1) / (n1-1) / n1;
+      double t  = (s[0]/n0 - s[1]/n1) / sqrt(a0 + a1);
+      return cmp ? fabs(t) : t; }
+    default: {                  // F is monotone in the between sum of sq.
+      double sb = 0, nt = 0;
+      for (int g = 0; g < k; g++) {
+        sb += s[g]*s[g]/(double)cnt[g];
+        st += s[g]; qt += q[g]; nt += (double)cnt[g];
+      }
+      if (cmp) return sb;
+      sb -= st*st/nt;
+      return (sb/(double)(k-1)) / ((qt - st*st/nt - sb)/(nt-(double)k)); }
+  }
+}  // labval()
+
+/*--------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define tres      stres
+#define grp       sgrp
+#define mean      smean
+#define grpinitl  sgrpinitl
+#define tstat2l   ststat2l
+#define welchtl   swelchtl
+#define anova1l   sanova1l
+#define perml     sperml
+#define permlb    spermlb
+#define labacc    slabacc
+#define labmom    slabmom
+#define labjob    slabjob
+#define labtask   slabtask
+#include "stats_lab_real.c"     // single precision versions
+#undef REAL
+#undef tres
+#undef grp
+#undef mean
+#undef grpinitl
+#undef tstat2l
+#undef welchtl
+#undef anova1l
+#undef perml
+#undef permlb
+#undef labacc
+#undef labmom
+#undef labjob
+#undef labtask
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define tres      dtres
+#define grp       dgrp
+#define mean      dmean
+#define grpinitl  dgrpinitl
+#define tstat2l   dtstat2l
+#define welchtl   dwelchtl
+#define anova1l   danova1l
+#define perml     dperml
+#define permlb    dpermlb
+#define labacc    dlabacc
+#define labmom    dlabmom
+#define labjob    dlabjob
+#define labtask   dlabtask
+#include "stats_lab_real.c"     // double precision versions
+#undef REAL
+#undef tres
+#undef grp
+#undef mean
+#undef grpinitl
+#undef tstat2l
+#undef welchtl
+#undef anova1l
+#undef perml
+#undef permlb
+#undef labacc
+#undef labmom
+#undef labjob
+#undef labtask
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
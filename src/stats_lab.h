@@ -0,0 +1,168 @@
+/*----------------------------------------------------------------------------
+  File    : stats_lab.h
+  Contents: group statistics and tests based on label vectors
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_LAB_H
+#define STATS_LAB_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "stats.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define LAB_MDIFF   0           // mean difference (see perml())
+#define LAB_T2      1           // two-sample t statistic (pooled variance)
+#define LAB_WELCH   2           // Welch's t statistic
+#define LAB_ANOVA1  3           // one-way analysis of variance
+
+#define LAB_MAXK    256         // maximum number of groups (uint8 labels)
+#define LAB_LANES   8           // number of accumulators per quantity
+#define LAB_BLOCK   1024        // number of values per block
+// The data are stored in any order (e.g., acquisition order); the group
+// of value i is given by the label lab[i] (0, ..., k-1). For two groups,
+// the sums (and sums of squares) of the total and of group 1 are computed
+// in a single pass over the data with label-masked accumulation (the
+// label is used as a 0/1 weight, LAB_LANES accumulators per quantity,
+// which allows the compiler to vectorize the loop); the lane sums of each
+// block of LAB_BLOCK values are added in double precision, and group 0
+// is obtained as the difference. For more groups, the values are
+// accumulated by label in double precision (which is faster than one
+// masked accumulation per group).
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* grpinitl
+ * --------
+ * prepare k groups given by a label vector (see grpinit())
+ *
+ * a    data (n values)
+ * lab  labels (n values in 0, ..., k-1)
+ * n    number of values
+ * k    number of groups (1 <= k <= LAB_MAXK)
+ * g    buffer for the k prepared groups (empty groups have n = 0)
+ *
+ * returns
+ * 0 on success, -1 if a label is >= k
+ */
+extern int    sgrpinitl (const float  *a, const unsigned char *lab, int n,
+                         int k, sgrp *g);
+extern int    dgrpinitl (const double *a, const unsigned char *lab, int n,
+                         int k, dgrp *g);
+
+/* tstat2l, welchtl
+ * ----------------
+ * two-sample t statistic (pooled variance) or Welch's t statistic of the
+ * groups with labels 0 and 1 (same as tstat2() and welcht() with x1 and
+ * x2 being groups 0 and 1, respectively)
+ *
+ * returns
+ * the statistic; NaN if a label is > 1 or a group has fewer than 2 values
+ */
+extern float  ststat2l (const float  *a, const unsigned char *lab, int n);
+extern double dtstat2l (const double *a, const unsigned char *lab, int n);
+extern stres  swelchtl (const float  *a, const unsigned char *lab, int n);
+extern dtres  dwelchtl (const double *a, const unsigned char *lab, int n);
+
+/* anova1l
+ * -------
+ * one-way analysis of variance of k groups given by a label vector
+ * (same as anova1() with the groups stored contiguously)
+ *
+ * returns
+ * the F statistic with df = (k-1, n-k); NaN if a label is >= k or a
+ * group is empty
+ */
+extern float  sanova1l (const float  *a, const unsigned char *lab, int n,
+                        int k);
+extern double danova1l (const double *a, const unsigned char *lab, int n,
+                        int k);
+
+/* perml
+ * -----
+ * permutation test with permuted label vectors
+ *
+ * Instead of reordering the data (perm()), each permutation is given as
+ * a permuted copy of the label vector (one byte per value instead of one
+ * int). The data are centered once. As the total sum and sum of squares
+ * do not depend on the labels, each permutation then requires a single
+ * pass over the data (see above) that yields the sums of the groups (and
+ * their sums of squares for LAB_WELCH):
+ *  - LAB_MDIFF, LAB_T2: |sum of group 1| (monotone in |t|)
+ *  - LAB_WELCH:         |t| of Welch's test
+ *  - LAB_ANOVA1:        between sum of squares (monotone in F)
+ *
+ * a     data (n values)
+ * lab   observed labels (n values in 0, ..., k-1)
+ * n     number of values
+ * k     number of groups (2 for LAB_MDIFF, LAB_T2 and LAB_WELCH)
+ * prm   permuted label vectors (np x n values, each a permutation of lab)
+ * np    number of permutations
+ * test  LAB_MDIFF, LAB_T2, LAB_WELCH or LAB_ANOVA1
+ * tmp   buffer for n REAL values
+ * s     If a valid ptr is passed, it will be used to store the statistic.
+ *       If you need only the p value, pass NULL.
+ *
+ * returns
+ * p value; -1 if a label is >= k or a group is too small
+ */
+extern float  sperml (const float  *a, const unsigned char *lab, int n,
+                      int k, const unsigned char *prm, int np, int test,
+                      float  *tmp, float  *s);
+extern double dperml (const double *a, const unsigned char *lab, int n,
+                      int k, const unsigned char *prm, int np, int test,
+                      double *tmp, double *s);
+
+/* permlb
+ * ------
+ * permutation tests of m data sets with the same labels and permutations
+ * (e.g., one per voxel; see perml())
+ *
+ * X         data (m data sets of n values, data set j starts at X+j*n)
+ * pv        buffer for the m p values
+ * s         buffer for the m statistics or NULL
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * 0 on success, -1 if the labels are invalid or memory allocation failed
+ */
+extern int    spermlb (const float  *X, const unsigned char *lab, int n,
+                       int m, int k, const unsigned char *prm, int np,
+                       int test, float  *pv, float  *s, int nthreads);
+extern int    dpermlb (const double *X, const unsigned char *lab, int n,
+                       int m, int k, const unsigned char *prm, int np,
+                       int test, double *pv, double *s, int nthreads);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define grpinitl  dgrpinitl
+#    define tstat2l   dtstat2l
+#    define welchtl   dwelchtl
+#    define anova1l   danova1l
+#    define perml     dperml
+#    define permlb    dpermlb
+#  else
+#    define grpinitl  sgrpinitl
+#    define tstat2l   ststat2l
+#    define welchtl   swelchtl
+#    define anova1l   sanova1l
+#    define perml     sperml
+#    define permlb    spermlb
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_LAB_H
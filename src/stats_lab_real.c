@@ -0,0 +1,234 @@
+/*----------------------------------------------------------------------------
+  File    : stats_lab_real.c
+  Contents: this file is to be included from stats_lab.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- data for labtask()
+  const REAL          *X;       // data sets
+  const unsigned char *lab;     // observed labels
+  const unsigned char *prm;     // permuted labels
+  int   n, k, np, test;         // see perml()
+  REAL *pv, *s;                 // p values and statistics
+  int   err;                    // error flag
+} labjob;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void labacc (const REAL *x, REAL c, const unsigned char *lab,
+                    int n, int k, int sq, double *s, double *q)
+{                               // --- sums (of squares) of x-c per group
+  enum { L = LAB_LANES };       // (q is only used if sq != 0)
+  for (int g = 0; g < k; g++) {
+    s[g] = 0; if (sq) q[g] = 0; }
+
+  if (k != 2) {                 // other than two groups:
+    for (int i = 0; i < n; i++) {   // accumulate by label
+      double d = (double)(x[i] - c);
+      s[lab[i]] += d; if (sq) q[lab[i]] += d*d;
+    }
+    return;
+  }
+
+  for (int b = 0; b < n; b += LAB_BLOCK) {  // two groups:
+    const REAL          *xb = x   + b;      // label-masked accumulation
+    const unsigned char *lb = lab + b;      // (t: total, u: group 1)
+    int  len = (n-b < LAB_BLOCK) ? n-b : LAB_BLOCK;
+    int  e   = len - len % L;
+    REAL t[L], u[L], tq[L], uq[L];
+    for (int l = 0; l < L; l++)
+      t[l] = u[l] = tq[l] = uq[l] = 0;
+    if (sq)
+      for (int i = 0; i < e; i += L)
+        for (int l = 0; l < L; l++) {
+          REAL d = xb[i+l] - c, m = (REAL)lb[i+l] * d;
+          t[l] += d; tq[l] += d*d; u[l] += m; uq[l] += m*m;
+        }
+    else
+      for (int i = 0; i < e; i += L)
+        for (int l = 0; l < L; l++) {
+          REAL d = xb[i+l] - c;
+          t[l] += d; u[l] += (REAL)lb[i+l] * d;
+        }
+    for (int i = e; i < len; i++) {
+      REAL d = xb[i] - c, m = (REAL)lb[i] * d;
+      t[0] += d; tq[0] += d*d; u[0] += m; uq[0] += m*m;
+    }
+    for (int l = 0; l < L; l++) {   // add the lane sums of the block
+      s[0] += (double)t[l]; s[1] += (double)u[l];
+      if (sq) { q[0] += (double)tq[l]; q[1] += (double)uq[l]; }
+    }
+  }
+  s[0] -= s[1];                 // group 0 = total - group 1
+  if (sq) q[0] -= q[1];
+}  // labacc()
+
+/*--------------------------------------------------------------------------*/
+
+static int labmom (const REAL *a, const unsigned char *lab, int n, int k,
+                   int *cnt, double *m, double *m2)
+{                               // --- counts, means and sums of squared
+  if (labcnt(lab, n, k, cnt) != 0)      // deviations of the groups
+    return -1;
+  REAL c = a[0];                // shift to reduce cancellation
+  labacc(a, c, lab, n, k, 1, m, m2);
+  for (int g = 0; g < k; g++) {
+    double ng = (double)cnt[g];
+    if (cnt[g] == 0) { m[g] = m2[g] = 0; continue; }
+    m2[g] -= m[g]*m[g]/ng;
+    if (m2[g] < 0) m2[g] = 0;
+    m [g]  = (double)c + m[g]/ng;
+  }
+  return 0;
+}  // labmom()
+
+/*--------------------------------------------------------------------------*/
+
+static void labtask (void *data, int tid, int beg, int end)
+{                               // --- process a range of data sets
+  labjob *j = (labjob*)data;
+  REAL *tmp = (REAL*) malloc((size_t)j->n *sizeof(REAL));
+  if (!tmp) { j->err = -1; return; }
+  for (int v = beg; v < end; v++) {
+    j->pv[v] = perml(j->X + (size_t)v*(size_t)j->n, j->lab, j->n, j->k,
+                     j->prm, j->np, j->test, tmp, j->s ? j->s+v : NULL);
+    if (j->pv[v] < 0) j->err = -1;
+  }
+  free(tmp);
+}  // labtask()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+int grpinitl (const REAL *a, const unsigned char *lab, int n, int k,
+              grp *g)
+{
+  assert(a && lab && (n > 0) && (k > 0) && (k <= LAB_MAXK) && g);
+
+  int    cnt[LAB_MAXK];
+  double m[LAB_MAXK], m2[LAB_MAXK];
+  if (labmom(a, lab, n, k, cnt, m, m2) != 0)
+    return -1;
+  for (int i = 0; i < k; i++) {
+    g[i].n  = cnt[i];
+    g[i].m  = (REAL)m[i];
+    g[i].m2 = (REAL)m2[i];
+  }
+  return 0;
+}  // grpinitl()
+
+/*--------------------------------------------------------------------------*/
+
+REAL tstat2l (const REAL *a, const unsigned char *lab, int n)
+{
+  assert(a && lab && (n > 0));
+
+  int    cnt[LAB_MAXK];
+  double m[2], m2[2];
+  if ((labmom(a, lab, n, 2, cnt, m, m2) != 0)
+  ||  (cnt[0] < 2) || (cnt[1] < 2))
+    return (REAL)NAN;
+  double n0 = (double)cnt[0], n1 = (double)cnt[1];
+  return (REAL)((m[0] - m[1])
+              / sqrt((m2[0] + m2[1]) / (n0+n1-2) * (1/n0 + 1/n1)));
+}  // tstat2l()
+
+/*--------------------------------------------------------------------------*/
+
+tres welchtl (const REAL *a, const unsigned char *lab, int n)
+{
+  assert(a && lab && (n > 0));
+
+  int    cnt[LAB_MAXK];
+  double m[2], m2[2];
+  tres   res = { .t = (REAL)NAN, .df = (REAL)NAN };
+  if ((labmom(a, lab, n, 2, cnt, m, m2) != 0)
+  ||  (cnt[0] < 2) || (cnt[1] < 2))
+    return res;
+  double n0 = (double)cnt[0], n1 = (double)cnt[1];
+  double a0 = m2[0] / (n0-1) / n0;     // squared standard errors
+  double a1 = m2[1] / (n1-1) / n1;
+  res.t  = (REAL)((m[0] - m[1]) / sqrt(a0 + a1));
+  res.df = (REAL)((a0+a1)*(a0+a1) / (a0*a0/(n0-1) + a1*a1/(n1-1)));
+  return res;
+}  // welchtl()
+
+/*--------------------------------------------------------------------------*/
+
+REAL anova1l (const REAL *a, const unsigned char *lab, int n, int k)
+{
+  assert(a && lab && (n > 0) && (k > 1) && (k <= LAB_MAXK));
+
+  int    cnt[LAB_MAXK];
+  double m[LAB_MAXK], m2[LAB_MAXK];
+  if ((labmom(a, lab, n, k, cnt, m, m2) != 0) || (n <= k))
+    return (REAL)NAN;
+  double mt = 0;                // grand mean
+  for (int g = 0; g < k; g++) {
+    if (cnt[g] == 0) return (REAL)NAN;
+    mt += (double)cnt[g] * m[g];
+  }
+  mt /= (double)n;
+  double sb = 0, sw = 0;        // between and within sums of squares
+  for (int g = 0; g < k; g++) {
+    sb += (double)cnt[g] * (m[g]-mt)*(m[g]-mt);
+    sw += m2[g];
+  }
+  return (REAL)((sb/(double)(k-1)) / (sw/(double)(n-k)));
+}  // anova1l()
+
+/*--------------------------------------------------------------------------*/
+
+REAL perml (const REAL *a, const unsigned char *lab, int n, int k,
+            const unsigned char *prm, int np, int test, REAL *tmp, REAL *s)
+{
+  assert(a && lab && (n > 0) && prm && (np > 0) && tmp);
+  assert((test == LAB_ANOVA1) ? ((k > 1) && (k <= LAB_MAXK)) : (k == 2));
+
+  int cnt[LAB_MAXK];                        // check the groups
+  if ((labcnt(lab, n, k, cnt) != 0) || (n <= k))
+    return -1;
+  for (int g = 0; g < k; g++)
+    if (cnt[g] < ((test == LAB_WELCH) ? 2 : 1))
+      return -1;
+
+  REAL m = mean(a, n);                      // center the data
+  for (int j = 0; j < n; j++)
+    tmp[j] = a[j] - m;
+
+  double sg[LAB_MAXK], qg[LAB_MAXK];        // observed sums (of squares)
+  labacc(tmp, 0, lab, n, k, 1, sg, qg);
+  if (s)
+    *s = (REAL)labval(test, cnt, k, sg, qg, 0);
+  double v  = labval(test, cnt, k, sg, qg, 1);
+  int    sq = (test == LAB_WELCH);
+
+  int c = 0;                                // initialize counter
+  for (int i = 0; i < np; i++) {            // for each permutation
+    labacc(tmp, 0, prm + (size_t)i*(size_t)n, n, k, sq, sg, qg);
+    if (labval(test, cnt, k, sg, qg, 1) >= v)
+      c++;                                  // count how many statistics
+  }                                         // were as or more extreme
+
+  return (REAL)(c + 1)/(REAL)(np + 1);      // return the p value
+}  // perml()
+
+/*--------------------------------------------------------------------------*/
+
+int permlb (const REAL *X, const unsigned char *lab, int n, int m, int k,
+            const unsigned char *prm, int np, int test,
+            REAL *pv, REAL *s, int nthreads)
+{
+  assert(X && lab && (n > 0) && (m > 0) && prm && (np > 0) && pv);
+
+  labjob j = { .X = X, .lab = lab, .prm = prm, .n = n, .k = k,
+               .np = np, .test = test, .pv = pv, .s = s, .err = 0 };
+  stats_parfor(nthreads, m, labtask, &j);
+  return j.err;
+}  // permlb()
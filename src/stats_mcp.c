@@ -0,0 +1,96 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mcp.c
+  Contents: multiple comparison procedures (FDR and FWER control)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats_mcp.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define RADIX_BITS  11          // number of bits per radix sort pass
+#define RADIX_SIZE  (1 << RADIX_BITS)
+#define MCP_CHUNK   65536       // minimum number of values per chunk
+
+#define STEP_KEYS   0           // steps of the thread-parallel loops
+#define STEP_HIST   1
+#define STEP_SCAT   2
+#define STEP_SCAN   3
+#define STEP_APPLY  4
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static double harmonic (int m)
+{                               // --- sum_{i=1}^m 1/i (BY correction)
+  double s = 0;                 // (smallest terms first)
+  for (int i = m; i > 0; i--)
+    s += 1/(double)i;
+  return s;
+}  // harmonic()
+
+/*--------------------------------------------------------------------------*/
+
+static int nchunks (int n, int nthreads)
+{                               // --- number of chunks (one per thread,
+  int nc = stats_nthreads(nthreads);    // but not too small)
+  if (n/MCP_CHUNK < nc)
+    nc = (n/MCP_CHUNK > 1) ? n/MCP_CHUNK : 1;
+  return nc;
+}  // nchunks()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define ukey      uint32_t
+#define padjust   spadjust
+#define fdr       sfdr
+#define mcpjob    smcpjob
+#define mcptask   smcptask
+#define mcpsort   smcpsort
+#include "stats_mcp_real.c"     // single precision versions
+#undef REAL
+#undef ukey
+#undef padjust
+#undef fdr
+#undef mcpjob
+#undef mcptask
+#undef mcpsort
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define ukey      uint64_t
+#define padjust   dpadjust
+#define fdr       dfdr
+#define mcpjob    dmcpjob
+#define mcptask   dmcptask
+#define mcpsort   dmcpsort
+#include "stats_mcp_real.c"     // double precision versions
+#undef REAL
+#undef ukey
+#undef padjust
+#undef fdr
+#undef mcpjob
+#undef mcptask
+#undef mcpsort
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
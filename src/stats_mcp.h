@@ -0,0 +1,93 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mcp.h
+  Contents: multiple comparison procedures (FDR and FWER control)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_MCP_H
+#define STATS_MCP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define MCP_BH      0           // Benjamini-Hochberg (FDR)
+#define MCP_BY      1           // Benjamini-Yekutieli (FDR, any dependency)
+#define MCP_HOLM    2           // Holm (FWER)
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* padjust
+ * -------
+ * adjust p values for multiple comparisons (in place)
+ *
+ * The p values are sorted with a thread-parallel LSD radix sort of their
+ * bit patterns (which are ordered like the values for p >= 0), using 11
+ * bits per pass and skipping passes in which all values have the same
+ * digit. The cumulative minimum (BH, BY) or maximum (Holm) of the scaled
+ * sorted p values is then computed in two parallel passes over contiguous
+ * chunks, with a sequential scan over the chunk results in between. The
+ * results are the same as those of R's p.adjust(), irrespective of the
+ * number of threads.
+ *
+ * p         p values in [0,1] (n values; NaNs are not counted as tests
+ *           and are left unchanged)
+ * n         number of p values
+ * method    MCP_BH, MCP_BY or MCP_HOLM
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed (p is then unchanged)
+ */
+extern int spadjust (float  *p, int n, int method, int nthreads);
+extern int dpadjust (double *p, int n, int method, int nthreads);
+
+/* fdr
+ * ---
+ * find the threshold of the Benjamini-Hochberg (or -Yekutieli) procedure
+ * without sorting
+ *
+ * With m tests and q' = q (BH) or q' = q / sum_{i=1}^m 1/i (BY), the
+ * procedure rejects all p <= p_(k), where k is the largest index with
+ * p_(k) <= k q'/m. Since #{p <= j q'/m} >= j holds exactly for j = k,
+ * the p values <= q' are counted in the bins (j-1, j] q'/m, j = 1..m, and
+ * k is found by one scan over the cumulative counts. This takes O(n)
+ * time and m+1 ints of memory.
+ *
+ * p         p values in [0,1] (n values; NaNs are not counted as tests)
+ * n         number of p values
+ * q         FDR level (e.g., 0.05; q > 0)
+ * method    MCP_BH or MCP_BY
+ * thr       where to store the threshold p_(k) (0 if k = 0), or NULL
+ *
+ * returns
+ * the number k of rejected hypotheses, -1 if memory allocation failed
+ */
+extern int sfdr     (const float  *p, int n, float  q, int method,
+                     float  *thr);
+extern int dfdr     (const double *p, int n, double q, int method,
+                     double *thr);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define padjust   dpadjust
+#    define fdr       dfdr
+#  else
+#    define padjust   spadjust
+#    define fdr       sfdr
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_MCP_H
@@ -0,0 +1,213 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mcp_real.c
+  Contents: this file is to be included from stats_mcp.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- job for the thread-parallel loops
+  int        step;              // step (STEP_KEYS, STEP_HIST, ...)
+  REAL       *p;                // p values (adjusted in place)
+  int        n;                 // number of p values
+  int        m;                 // number of tests (non-NaN p values)
+  int        nc;                // number of chunks
+  int        method;            // MCP_BH, MCP_BY or MCP_HOLM
+  double     f;                 // factor m (BH) or m sum 1/i (BY)
+  ukey       *k, *kt;           // keys (bit patterns of the p values)
+  int        *ix, *it;          // indices of the p values
+  size_t     *h;                // histograms/offsets (nc x RADIX_SIZE)
+  int        sh;                // shift of the current digit
+  double     *e;                // chunk minima/maxima (then carries)
+} mcpjob;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void mcptask (void *data, int tid, int beg, int end)
+{                               // --- process a range of chunks
+  mcpjob *j = (mcpjob*)data;
+  ukey   mk = (ukey)(RADIX_SIZE-1);
+  for (int c = beg; c < end; c++) {
+    int lo = (int)((long long)c     * j->n / j->nc);
+    int hi = (int)((long long)(c+1) * j->n / j->nc);
+    size_t *h = j->h + (size_t)c*RADIX_SIZE;
+    switch (j->step) {
+      case STEP_KEYS:           // get the bit patterns
+        for (int i = lo; i < hi; i++) {
+          REAL x = j->p[i];
+          if (x == 0) x = 0;    // (map -0 to +0)
+          memcpy(j->k+i, &x, sizeof(ukey));
+          j->ix[i] = i;
+        }
+        break;
+      case STEP_HIST:           // count the digits
+        for (int b = 0; b < RADIX_SIZE; b++)
+          h[b] = 0;
+        for (int i = lo; i < hi; i++)
+          h[(j->k[i] >> j->sh) & mk]++;
+        break;
+      case STEP_SCAT:           // move the keys to their positions
+        for (int i = lo; i < hi; i++) {
+          size_t o = h[(j->k[i] >> j->sh) & mk]++;
+          j->kt[o] = j->k[i];
+          j->it[o] = j->ix[i];
+        }
+        break;
+      default: {                // scale the sorted p values and
+        REAL   x;               // compute their cumulative min./max.
+        double r = j->e[c];
+        if (hi > j->m) hi = j->m;
+        if (j->method == MCP_HOLM) {
+          for (int i = lo; i < hi; i++) {
+            memcpy(&x, j->k+i, sizeof(REAL));
+            double v = (double)(j->m - i) * (double)x;
+            r = (v > r) ? v : r;
+            if (j->step == STEP_APPLY)
+              j->p[j->ix[i]] = (REAL)((r < 1) ? r : 1);
+          }
+        }
+        else {                  // (BH, BY: from the largest p value)
+          for (int i = hi-1; i >= lo; i--) {
+            memcpy(&x, j->k+i, sizeof(REAL));
+            double v = j->f * (double)x / (double)(i+1);
+            r = (v < r) ? v : r;
+            if (j->step == STEP_APPLY)
+              j->p[j->ix[i]] = (REAL)((r < 1) ? r : 1);
+          }
+        }
+        if (j->step == STEP_SCAN)
+          j->e[c] = r;
+        break; }
+    }
+  }
+}  // mcptask()
+
+/*--------------------------------------------------------------------------*/
+
+static void mcpsort (mcpjob *j, int nthreads)
+{                               // --- sort the p values (LSD radix sort)
+  j->step = STEP_KEYS;
+  stats_parfor(nthreads, j->nc, mcptask, j);
+  for (j->sh = 0; j->sh < (int)(8*sizeof(ukey)); j->sh += RADIX_BITS) {
+    j->step = STEP_HIST;
+    stats_parfor(nthreads, j->nc, mcptask, j);
+    size_t o = 0;               // compute the offsets of the chunks
+    int    skip = 0;            // (bucket by bucket)
+    for (int b = 0; (b < RADIX_SIZE) && !skip; b++) {
+      size_t t = 0;
+      for (int c = 0; c < j->nc; c++) {
+        size_t *h = j->h + (size_t)c*RADIX_SIZE + b;
+        size_t  q = *h; *h = o + t; t += q;
+      }
+      skip = (t == (size_t)j->n); // (skip the pass if all keys
+      o += t;                   //  have the same digit)
+    }
+    if (skip) continue;
+    j->step = STEP_SCAT;
+    stats_parfor(nthreads, j->nc, mcptask, j);
+    ukey *k = j->k; j->k  = j->kt; j->kt = k;
+    int  *i = j->ix; j->ix = j->it; j->it = i;
+  }
+}  // mcpsort()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+int padjust (REAL *p, int n, int method, int nthreads)
+{
+  assert(p && (n > 0)
+         && ((method == MCP_BH) || (method == MCP_BY)
+             || (method == MCP_HOLM)));
+
+  mcpjob j = { .p = p, .n = n, .method = method };
+  j.nc = nchunks(n, nthreads);
+  void *buf = malloc((size_t)n * 2*(sizeof(ukey) + sizeof(int))
+                   + (size_t)j.nc * (RADIX_SIZE*sizeof(size_t)
+                                     + sizeof(double)));
+  if (!buf) return -1;
+  j.h  = (size_t*)buf;
+  j.k  = (ukey*)(j.h + (size_t)j.nc*RADIX_SIZE);
+  j.kt = j.k + n;
+  j.e  = (double*)(j.kt + n);
+  j.ix = (int*)(j.e + j.nc);
+  j.it = j.ix + n;
+  mcpsort(&j, nthreads);
+
+  REAL x;                       // count the tests (the NaNs are sorted
+  for (j.m = n; j.m > 0; j.m--) {   // to the end)
+    memcpy(&x, j.k + j.m-1, sizeof(REAL));
+    if (!isnan(x)) break;
+  }
+  j.f = (method == MCP_BY) ? (double)j.m * harmonic(j.m) : (double)j.m;
+
+  // compute the cumulative min./max. per chunk, combine them
+  // sequentially into the carries of the chunks, and then apply them
+  double r = (method == MCP_HOLM) ? 0 : INFINITY;
+  for (int c = 0; c < j.nc; c++)
+    j.e[c] = r;
+  j.step = STEP_SCAN;
+  stats_parfor(nthreads, j.nc, mcptask, &j);
+  for (int l = 0; l < j.nc; l++) {
+    int    c = (method == MCP_HOLM) ? l : j.nc-1-l;
+    double t = j.e[c];
+    j.e[c] = r;
+    if (method == MCP_HOLM) r = (t > r) ? t : r;
+    else                    r = (t < r) ? t : r;
+  }
+  j.step = STEP_APPLY;
+  stats_parfor(nthreads, j.nc, mcptask, &j);
+  free(buf);
+  return 0;
+}  // padjust()
+
+/*--------------------------------------------------------------------------*/
+
+int fdr (const REAL *p, int n, REAL q, int method, REAL *thr)
+{
+  assert(p && (n > 0) && (q > 0)
+         && ((method == MCP_BH) || (method == MCP_BY)));
+
+  if (thr) *thr = 0;
+  if (!(q > 0)) return 0;       // (no rejections, avoids a = 0 below)
+  int m = 0;                    // count the tests
+  for (int i = 0; i < n; i++)
+    m += !isnan(p[i]);
+  if (m == 0) return 0;
+  int *cnt = (int*) calloc((size_t)m+1, sizeof(int));
+  if (!cnt) return -1;
+
+  // count the p values in the bins (j-1, j] q'/m
+  double a = (double)q / (double)m;
+  if (method == MCP_BY) a /= harmonic(m);
+  double amax = (double)m * a;
+  for (int i = 0; i < n; i++) {
+    double x = (double)p[i];
+    if (!(x <= amax)) continue; // (also skips the NaNs)
+    int b = (int)ceil(x / a);
+    if (b < 1) b = 1;
+    if (b > m) b = m;           // correct the bin index for rounding
+    if      ((b > 1) && (x <= (double)(b-1) * a)) b--;
+    else if (x > (double)b * a) b++;
+    if (b <= m) cnt[b]++;
+  }
+
+  int k = 0, c = 0;             // find the largest k with
+  for (int b = 1; b <= m; b++) {    // #{p <= k q'/m} >= k
+    c += cnt[b];
+    if (c >= b) k = b;
+  }
+  free(cnt);
+
+  if (thr && (k > 0)) {         // find the largest rejected p value
+    double t = (double)k * a;
+    REAL   mx = 0;
+    for (int i = 0; i < n; i++)
+      if (((double)p[i] <= t) && (p[i] > mx)) mx = p[i];
+    *thr = mx;
+  }
+  return k;
+}  // fdr()
@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mmap.c
+  Contents: voxelwise statistics over memory-mapped raw data files
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE         // for madvise() and the MADV_* flags
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "stats_mmap.h"
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- memory-mapped file
+  void   *base;                 // start of the mapping
+  size_t len;                   // length of the mapping in bytes
+} mmfile;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static int mapin (const char *name, size_t len, mmfile *m)
+{                               // --- map an input file (read only)
+  int fd = open(name, O_RDONLY);
+  if (fd < 0) return -1;
+  struct stat st;               // check that the file is large enough
+  if (fstat(fd, &st) != 0) {
+    close(fd); return -1; }
+  if ((size_t)st.st_size < len) {
+    close(fd); errno = EINVAL; return -1; }
+  void *p = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);                    // the mapping keeps the file open
+  if (p == MAP_FAILED) return -1;
+  madvise(p, len, MADV_SEQUENTIAL);
+  m->base = p; m->len = len;    // each row is read front to back
+  return 0;
+}  // mapin()
+
+/*--------------------------------------------------------------------------*/
+
+static int mapout (const char *name, size_t len, mmfile *m)
+{                               // --- create and map an output file
+  int fd = open(name, O_RDWR|O_CREAT|O_TRUNC, 0644);
+  if (fd < 0) return -1;
+  if (ftruncate(fd, (off_t)len) != 0) {
+    close(fd); return -1; }
+  void *p = mmap(NULL, len, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return -1;
+  m->base = p; m->len = len;
+  return 0;
+}  // mapout()
+
+/*--------------------------------------------------------------------------*/
+
+static int unmap (mmfile *m, int sync)
+{                               // --- unmap a file
+  int r = 0;
+  if (!m->base) return 0;
+  if (sync && (msync(m->base, m->len, MS_SYNC) != 0))
+    r = -1;                     // write back the results (output files)
+  munmap(m->base, m->len);
+  m->base = NULL;
+  return r;
+}  // unmap()
+
+/*--------------------------------------------------------------------------*/
+
+static void advise (const void *beg, const void *end, int adv)
+{                               // --- give advice on a range of pages
+  uintptr_t ps = (uintptr_t)sysconf(_SC_PAGESIZE);
+  uintptr_t b  = (uintptr_t)beg & ~(ps-1);
+  uintptr_t e  = (uintptr_t)end;
+  if (adv == MADV_DONTNEED)     // release only pages that lie entirely
+    e &= ~(ps-1);               // before the end of the range,
+  else                          // but read ahead all pages that
+    e = (e + ps-1) & ~(ps-1);   // overlap with the range
+  if (e > b)
+    madvise((void*)b, (size_t)(e-b), adv);
+}  // advise()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define mmtile    smmtile
+#define mmload    smmload
+#define mmstats   smmstats
+#include "def-or-undef-functions.inc"
+#include "stats_mmap_real.c"    // single precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef mmtile
+#undef mmload
+#undef mmstats
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define mmtile    dmmtile
+#define mmload    dmmload
+#define mmstats   dmmstats
+#include "def-or-undef-functions.inc"
+#include "stats_mmap_real.c"    // double precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef mmtile
+#undef mmload
+#undef mmstats
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
@@ -0,0 +1,101 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mmap.h
+  Contents: voxelwise statistics over memory-mapped raw data files
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_MMAP_H
+#define STATS_MMAP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include "stats.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define MMSTATS_TILE  4096      // default number of voxels per tile
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* mmstats
+ * -------
+ * compute a statistic for each voxel of data that is stored in raw binary
+ * files, streaming the data tile by tile through memory-mapped views
+ *
+ * The data are read from either a single file holding an ntotal x nvox
+ * matrix in observation-major order (i.e., the nvox values of each
+ * observation are stored contiguously) or from ntotal files holding the
+ * nvox values of one observation (e.g., one subject) each. The values
+ * have to be stored in native byte order as float (smmstats) or double
+ * (dmmstats). For each tile of voxels, the data are gathered into a
+ * buffer such that the ntotal values of each voxel are contiguous; the
+ * statistic (and optionally the permutation p value) is computed and the
+ * results are written to memory-mapped output files.
+ *
+ * While one tile is being processed, the next tile is gathered by a
+ * prefetch thread into a second buffer (double buffering). The kernel is
+ * advised to read ahead the pages of the tile after that, and the pages
+ * of consumed tiles are released again, so that the peak memory is
+ * bounded by 2*tile*ntotal values (plus the page cache).
+ *
+ * files   names of the input files
+ *
+ * nfiles  number of input files (1 or ntotal)
+ *
+ * n       n[0] - number of data sets in sample #1
+ *         n[1] - number of data sets in sample #2
+ *         ...  - ...
+ *         (see the *_w wrappers and perm())
+ *
+ * ntotal  total number of data sets (observations)
+ *
+ * nvox    number of voxels
+ *
+ * func    mean_w, tstat_w, mdiff_w, tstat2_w, pairedt_w, didt_w, ...
+ *
+ * prm     permutations (see perm()) or NULL if no p values are needed
+ *
+ * np      number of permutations
+ *
+ * tile    number of voxels per tile (0 -> MMSTATS_TILE)
+ *
+ * sfile   name of the output file for the statistics (nvox values)
+ *         or NULL if the statistics are not needed
+ *
+ * pfile   name of the output file for the p values (nvox values)
+ *         or NULL if the p values are not needed (requires prm)
+ *
+ * returns
+ * 0 on success, -1 on error (errno is set accordingly)
+ */
+extern int smmstats (const char *const *files, int nfiles,
+                     int *n, int ntotal, size_t nvox, Func1s *func,
+                     const int *prm, int np, size_t tile,
+                     const char *sfile, const char *pfile);
+extern int dmmstats (const char *const *files, int nfiles,
+                     int *n, int ntotal, size_t nvox, Func1d *func,
+                     const int *prm, int np, size_t tile,
+                     const char *sfile, const char *pfile);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic name
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define mmstats   dmmstats
+#  else
+#    define mmstats   smmstats
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_MMAP_H
@@ -0,0 +1,146 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mmap_real.c
+  Contents: this file is to be included from stats_mmap.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- tile of voxels
+  const REAL **rows;            // data of the observations (mapped)
+  int        ntotal;            // number of observations
+  size_t     nvox;              // number of voxels
+  size_t     tile;              // number of voxels per tile
+  size_t     v0, v1;            // voxel range [v0,v1) of this tile
+  REAL       *buf;              // buffer for tile*ntotal values
+} mmtile;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void* mmload (void *arg)
+{                               // --- load a tile (prefetch thread)
+  mmtile *t = (mmtile*)arg;
+  int ntotal = t->ntotal;
+  size_t nx  = (t->v1 + t->tile < t->nvox) ? t->v1 + t->tile : t->nvox;
+
+  // read ahead the pages of the next tile
+  if (nx > t->v1)
+    for (int i = 0; i < ntotal; i++)
+      advise(t->rows[i] + t->v1, t->rows[i] + nx, MADV_WILLNEED);
+
+  // gather the data such that the values of each voxel are contiguous
+  // (in blocks of voxels to keep the written cache lines in cache)
+  for (size_t vb = t->v0; vb < t->v1; vb += 64) {
+    size_t ve = (vb + 64 < t->v1) ? vb + 64 : t->v1;
+    for (int i = 0; i < ntotal; i++) {
+      const REAL *src = t->rows[i];
+      REAL *dst = t->buf + (vb - t->v0)*(size_t)ntotal + (size_t)i;
+      for (size_t v = vb; v < ve; v++, dst += ntotal)
+        *dst = src[v];
+    }
+  }
+
+  // release the pages of this tile (and of the preceding tiles)
+  for (int i = 0; i < ntotal; i++)
+    advise(t->rows[i] + t->v0, t->rows[i] + t->v1, MADV_DONTNEED);
+
+  return NULL;
+}  // mmload()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+int mmstats (const char *const *files, int nfiles,
+             int *n, int ntotal, size_t nvox, Func1 *func,
+             const int *prm, int np, size_t tile,
+             const char *sfile, const char *pfile)
+{
+  assert(files && ((nfiles == 1) || (nfiles == ntotal)));
+  assert(n && (ntotal > 0) && (nvox > 0) && func);
+  assert(!pfile || (prm && (np > 0)));
+
+  if (tile == 0)   tile = MMSTATS_TILE;
+  if (tile > nvox) tile = nvox;
+
+  int r = -1;                   // result (error until proven otherwise)
+  mmfile out[2] = {{NULL, 0}, {NULL, 0}};
+  mmfile *in    = (mmfile*) calloc((size_t)nfiles, sizeof(mmfile));
+  const REAL **rows = (const REAL**) malloc((size_t)ntotal *sizeof(REAL*));
+  REAL *buf     = (REAL*) malloc((2*tile+1)*(size_t)ntotal *sizeof(REAL));
+  if (!in || !rows || !buf) {
+    errno = ENOMEM; goto cleanup; }
+  REAL *tmp = buf + 2*tile*(size_t)ntotal;  // buffer for perm()
+
+  // map the input file(s)
+  size_t len = nvox *sizeof(REAL);
+  if (nfiles == 1) {
+    if (mapin(files[0], (size_t)ntotal*len, in) != 0) goto cleanup;
+    for (int i = 0; i < ntotal; i++)
+      rows[i] = (const REAL*)in[0].base + (size_t)i*nvox;
+  }
+  else {
+    for (int i = 0; i < ntotal; i++) {
+      if (mapin(files[i], len, in+i) != 0) goto cleanup;
+      rows[i] = (const REAL*)in[i].base;
+    }
+  }
+
+  // map the output file(s)
+  if (sfile && (mapout(sfile, len, out)   != 0)) goto cleanup;
+  if (pfile && (mapout(pfile, len, out+1) != 0)) goto cleanup;
+  REAL *sv = (REAL*)out[0].base;
+  REAL *pv = (REAL*)out[1].base;
+
+  // load the first tile
+  mmtile cur = { .rows = rows, .ntotal = ntotal, .nvox = nvox,
+                 .tile = tile, .v0 = 0, .v1 = tile, .buf = buf };
+  mmload(&cur);
+
+  while (cur.v0 < nvox) {
+    // start loading the next tile into the other buffer
+    mmtile nxt = cur;
+    nxt.v0  = cur.v1;
+    nxt.v1  = (nxt.v0 + tile < nvox) ? nxt.v0 + tile : nvox;
+    nxt.buf = (cur.buf == buf) ? buf + tile*(size_t)ntotal : buf;
+    pthread_t thread;
+    int async = (nxt.v0 < nvox)
+             && (pthread_create(&thread, NULL, mmload, &nxt) == 0);
+
+    // process the current tile
+    for (size_t v = cur.v0; v < cur.v1; v++) {
+      const REAL *a = cur.buf + (v - cur.v0)*(size_t)ntotal;
+      REAL s;
+      if (pv) pv[v] = perm(a, n, ntotal, prm, np, func, tmp, &s);
+      else    s = func(a, n);
+      if (sv) sv[v] = s;
+    }
+
+    // wait for the next tile (or load it now if no thread was started)
+    if (async)
+      pthread_join(thread, NULL);
+    else if (nxt.v0 < nvox)
+      mmload(&nxt);
+    cur = nxt;
+  }
+  r = 0;
+
+  cleanup:
+  if (r != 0) {                 // preserve the errno of the failure
+    int e = errno;
+    unmap(out, 0); unmap(out+1, 0);
+    errno = e;
+  }
+  else if ((unmap(out, 1) != 0) | (unmap(out+1, 1) != 0))
+    r = -1;
+  if (in)
+    for (int i = 0; i < nfiles; i++)
+      unmap(in+i, 0);
+  free(in);
+  free(rows);
+  free(buf);
+  return r;
+}  // mmstats()
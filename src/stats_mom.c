@@ -0,0 +1,119 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mom.c
+  Contents: one-pass computation of a set of moments (query plans)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+#include "stats_mom.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- running quantities
+  double n;                     // number of values
+  double s;                     // sum
+  double m;                     // mean
+  double m2, m3, m4;            // sums of powers of deviations from m
+  double lo, hi;                // minimum and maximum
+} momacc;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void momcomb (momacc *a, const momacc *b, int order)
+{                               // --- combine the quantities of two parts
+  double na = a->n, nb = b->n, n = na + nb;  // (Pebay, 2008)
+  double d  = b->m - a->m, dn = d/n;
+  if (order >= 4)
+    a->m4 += b->m4 + d*dn*dn*dn * na*nb * (na*na - na*nb + nb*nb)
+           + 6*dn*dn * (na*na*b->m2 + nb*nb*a->m2)
+           + 4*dn * (na*b->m3 - nb*a->m3);
+  if (order >= 3)
+    a->m3 += b->m3 + d*dn*dn * na*nb * (na-nb)
+           + 3*dn * (na*b->m2 - nb*a->m2);
+  if (order >= 2)
+    a->m2 += b->m2 + d*dn * na*nb;
+  a->m  += dn*nb;
+  a->s  += b->s;
+  a->n   = n;
+  if (b->lo < a->lo) a->lo = b->lo;
+  if (b->hi > a->hi) a->hi = b->hi;
+}  // momcomb()
+
+/*--------------------------------------------------------------------------*/
+
+static void momout (const mplan *p, const momacc *a, double *r)
+{                               // --- derive the requested statistics
+  double n = a->n, v = a->m2/(n-1);
+  double x[MOM_NSTATS] = { a->s, a->m, v, sqrt(v), a->lo, a->hi,
+                           sqrt(n) * a->m3 / (a->m2*sqrt(a->m2)),
+                           n * a->m4 / (a->m2*a->m2),
+                           a->m / sqrt(v/n) };
+  for (int k = 0, o = 0; k < MOM_NSTATS; k++)
+    if (p->flags & (1u << k)) r[o++] = x[k];
+}  // momout()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+mplan mplaninit (unsigned flags)
+{
+  mplan p = { .flags = flags & MOM_ALL, .order = 0, .minmax = 0,
+              .nout = 0 };
+  if (flags & (MOM_SUM|MOM_MEAN))        p.order = 1;
+  if (flags & (MOM_VAR|MOM_STD|MOM_T))   p.order = 2;
+  if (flags &  MOM_SKEW)                 p.order = 3;
+  if (flags &  MOM_KURT)                 p.order = 4;
+  p.minmax = (flags & (MOM_MIN|MOM_MAX)) != 0;
+  for (int k = 0; k < MOM_NSTATS; k++)
+    p.nout += (int)((p.flags >> k) & 1u);
+  return p;
+}  // mplaninit()
+
+/*--------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define mpexec    smpexec
+#define mpexecb   smpexecb
+#define momjob    smomjob
+#define momblk    smomblk
+#define momtask   smomtask
+#include "stats_mom_real.c"     // single precision versions
+#undef REAL
+#undef mpexec
+#undef mpexecb
+#undef momjob
+#undef momblk
+#undef momtask
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define mpexec    dmpexec
+#define mpexecb   dmpexecb
+#define momjob    dmomjob
+#define momblk    dmomblk
+#define momtask   dmomtask
+#include "stats_mom_real.c"     // double precision versions
+#undef REAL
+#undef mpexec
+#undef mpexecb
+#undef momjob
+#undef momblk
+#undef momtask
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
@@ -0,0 +1,111 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mom.h
+  Contents: one-pass computation of a set of moments (query plans)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_MOM_H
+#define STATS_MOM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define MOM_SUM     0x0001      // sum
+#define MOM_MEAN    0x0002      // mean
+#define MOM_VAR     0x0004      // sample variance (n-1)
+#define MOM_STD     0x0008      // sample standard deviation
+#define MOM_MIN     0x0010      // minimum
+#define MOM_MAX     0x0020      // maximum
+#define MOM_SKEW    0x0040      // skewness sqrt(n) M3 / M2^(3/2)
+#define MOM_KURT    0x0080      // kurtosis n M4 / M2^2 (not excess)
+#define MOM_T       0x0100      // one-sample t statistic
+#define MOM_ALL     0x01ff      // all of the above
+#define MOM_NSTATS  9           // number of statistics
+
+#define MOM_LANES   8           // number of accumulators per quantity
+#define MOM_BLOCK   512         // number of values per block
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct mplan {          // --- query plan (see mplaninit())
+  unsigned flags;               // requested statistics (MOM_*)
+  int      order;               // highest central moment needed (0-4)
+  int      minmax;              // whether the minimum/maximum is needed
+  int      nout;                // number of outputs per array
+} mplan;
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* mplaninit
+ * ---------
+ * create a query plan for a set of statistics
+ *
+ * The plan determines the running quantities that have to be accumulated
+ * (sum, M2, M3, M4 and the minimum/maximum, as needed) and thus the
+ * kernel that is used. The outputs are stored in the order of the bits
+ * of flags (e.g., MOM_MEAN|MOM_MAX|MOM_T -> mean, max, t).
+ *
+ * flags  statistics to compute (MOM_* combined with |)
+ */
+extern mplan  mplaninit (unsigned flags);
+
+/* mpexec
+ * ------
+ * compute the statistics of a plan for an array in a single pass
+ *
+ * The data are processed in blocks of MOM_BLOCK values. The sums (and
+ * minima/maxima) of a block are accumulated in MOM_LANES independent
+ * lanes (branch-free loops over the lanes, vectorized by the compiler);
+ * if central moments are needed, the block, which is still in the cache,
+ * is then reduced to the sums of powers of the deviations from its mean.
+ * The blocks are combined in double precision with the pairwise update
+ * formulas of Pebay (2008). Hence the data are read from memory once,
+ * and no more is computed than the plan requires. NaNs are not handled.
+ *
+ * p    query plan
+ * a    data (n values; n > 1 for var, std, skew, kurt and t)
+ * out  buffer for the p->nout results
+ */
+extern void   smpexec   (const mplan *p, const float  *a, int n,
+                         float  *out);
+extern void   dmpexec   (const mplan *p, const double *a, int n,
+                         double *out);
+
+/* mpexecb
+ * -------
+ * compute the statistics of a plan for m arrays (thread-parallel)
+ *
+ * X         data (n x m, column-major)
+ * out       buffer for the results (p->nout x m)
+ * nthreads  number of threads (<= 0 -> number of processors)
+ */
+extern void   smpexecb  (const mplan *p, const float  *X, int n, int m,
+                         float  *out, int nthreads);
+extern void   dmpexecb  (const mplan *p, const double *X, int n, int m,
+                         double *out, int nthreads);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define mpexec    dmpexec
+#    define mpexecb   dmpexecb
+#  else
+#    define mpexec    smpexec
+#    define mpexecb   smpexecb
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_MOM_H
@@ -0,0 +1,134 @@
+/*----------------------------------------------------------------------------
+  File    : stats_mom_real.c
+  Contents: this file is to be included from stats_mom.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- job for the thread-parallel loops
+  const mplan *p;               // query plan
+  const REAL  *X;               // data (n x m)
+  int         n;                // number of values per array
+  REAL        *out;             // results (nout x m)
+} momjob;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void momblk (const REAL *x, int len, int order, int minmax,
+                    momacc *b)
+{                               // --- running quantities of a block
+  enum { L = MOM_LANES };
+  REAL s[L], lo[L], hi[L];
+  int  k = len - len % L;       // (number of values in full rounds)
+  for (int l = 0; l < L; l++) {
+    s[l] = 0; lo[l] = hi[l] = x[0]; }
+  if (minmax)                   // sums (and minima/maxima)
+    for (int i = 0; i < k; i += L)
+      for (int l = 0; l < L; l++) {
+        s[l] += x[i+l];
+        lo[l] = (x[i+l] < lo[l]) ? x[i+l] : lo[l];
+        hi[l] = (x[i+l] > hi[l]) ? x[i+l] : hi[l];
+      }
+  else
+    for (int i = 0; i < k; i += L)
+      for (int l = 0; l < L; l++)
+        s[l] += x[i+l];
+  for (int i = k; i < len; i++) {
+    s[0] += x[i];
+    lo[0] = (x[i] < lo[0]) ? x[i] : lo[0];
+    hi[0] = (x[i] > hi[0]) ? x[i] : hi[0];
+  }
+  b->n  = (double)len;
+  b->s  = 0; b->lo = (double)lo[0]; b->hi = (double)hi[0];
+  for (int l = 0; l < L; l++) {
+    b->s += (double)s[l];
+    if ((double)lo[l] < b->lo) b->lo = (double)lo[l];
+    if ((double)hi[l] > b->hi) b->hi = (double)hi[l];
+  }
+  b->m  = b->s / b->n;
+  b->m2 = b->m3 = b->m4 = 0;
+  if (order < 2) return;
+
+  // sums of powers of the deviations from the (rounded) block mean
+  REAL c = (REAL)b->m;
+  REAL q1[L], q2[L], q3[L], q4[L];
+  for (int l = 0; l < L; l++)
+    q1[l] = q2[l] = q3[l] = q4[l] = 0;
+  if (order == 2)
+    for (int i = 0; i < k; i += L)
+      for (int l = 0; l < L; l++) {
+        REAL d = x[i+l] - c;
+        q1[l] += d; q2[l] += d*d;
+      }
+  else if (order == 3)
+    for (int i = 0; i < k; i += L)
+      for (int l = 0; l < L; l++) {
+        REAL d = x[i+l] - c, d2 = d*d;
+        q1[l] += d; q2[l] += d2; q3[l] += d2*d;
+      }
+  else
+    for (int i = 0; i < k; i += L)
+      for (int l = 0; l < L; l++) {
+        REAL d = x[i+l] - c, d2 = d*d;
+        q1[l] += d; q2[l] += d2; q3[l] += d2*d; q4[l] += d2*d2;
+      }
+  for (int i = k; i < len; i++) {
+    REAL d = x[i] - c, d2 = d*d;
+    q1[0] += d; q2[0] += d2; q3[0] += d2*d; q4[0] += d2*d2;
+  }
+  double p1 = 0, p2 = 0, p3 = 0, p4 = 0;
+  for (int l = 0; l < L; l++) {
+    p1 += (double)q1[l]; p2 += (double)q2[l];
+    p3 += (double)q3[l]; p4 += (double)q4[l];
+  }
+  double n = b->n, e = p1/n;    // (convert to deviations from the mean)
+  b->m  = (double)c + e;
+  b->m2 = p2 - n*e*e;
+  b->m3 = p3 - 3*e*p2 + 2*n*e*e*e;
+  b->m4 = p4 - 4*e*p3 + 6*e*e*p2 - 3*n*e*e*e*e;
+}  // momblk()
+
+/*--------------------------------------------------------------------------*/
+
+static void momtask (void *data, int tid, int beg, int end)
+{                               // --- process a range of arrays
+  momjob *j = (momjob*)data;
+  for (int v = beg; v < end; v++)
+    mpexec(j->p, j->X + (size_t)v*(size_t)j->n, j->n,
+           j->out + (size_t)v*(size_t)j->p->nout);
+}  // momtask()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+void mpexec (const mplan *p, const REAL *a, int n, REAL *out)
+{
+  assert(p && a && (n > 0) && (out || (p->nout == 0)));
+
+  momacc acc = { 0, 0, 0, 0, 0, 0, INFINITY, -INFINITY }, b;
+  for (int i = 0; i < n; i += MOM_BLOCK) {
+    int len = (n-i < MOM_BLOCK) ? n-i : MOM_BLOCK;
+    momblk(a+i, len, p->order, p->minmax, &b);
+    momcomb(&acc, &b, p->order);
+  }
+  double r[MOM_NSTATS];
+  momout(p, &acc, r);
+  for (int k = 0; k < p->nout; k++)
+    out[k] = (REAL)r[k];
+}  // mpexec()
+
+/*--------------------------------------------------------------------------*/
+
+void mpexecb (const mplan *p, const REAL *X, int n, int m,
+              REAL *out, int nthreads)
+{
+  assert(p && X && (n > 0) && (m > 0) && (out || (p->nout == 0)));
+
+  momjob j = { .p = p, .X = X, .n = n, .out = out };
+  stats_parfor(nthreads, m, momtask, &j);
+}  // mpexecb()
@@ -10,9 +10,13 @@
 ----------------------------------------------------------------------------*/
 extern float  ssum_naive     (const float  *a, int n);
 extern float  svarm_naive    (const float  *a, int n, float  m);
+extern void   spivcnt_naive  (const float  *a, int n, float  p,
+                              int *lt, int *eq);
 
 extern double dsum_naive     (const double *a, int n);
 extern double dvarm_naive    (const double *a, int n, double m);
+extern void   dpivcnt_naive  (const double *a, int n, double p,
+                              int *lt, int *eq);
 
 extern double dssum_naive    (const float  *a, int n);
 // ... TODO
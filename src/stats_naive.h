@@ -35,10 +35,12 @@ inline double dssum_naive    (const float  *a, int n);
 #define sqrt          sqrtf
 #define sum_naive     ssum_naive
 #define varm_naive    svarm_naive
+#define pivcnt_naive  spivcnt_naive
 #include "stats_naive_real.h"   // single precision versions
 #undef sqrt
 #undef sum_naive
 #undef varm_naive
+#undef pivcnt_naive
 #undef REAL
 /*--------------------------------------------------------------------------*/
 #undef STATS_NAIVE_REAL_H       // undef guard to include header a 2nd time
@@ -46,9 +48,11 @@ inline double dssum_naive    (const float  *a, int n);
 #define REAL double             // (re)define REAL to be double
 #define sum_naive     dsum_naive
 #define varm_naive    dvarm_naive
+#define pivcnt_naive  dpivcnt_naive
 #include "stats_naive_real.h"   // double precision versions
 #undef sum_naive
 #undef varm_naive
+#undef pivcnt_naive
 #undef REAL
 /*--------------------------------------------------------------------------*/
 #undef REAL                     // restore original definition of REAL
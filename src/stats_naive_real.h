@@ -14,6 +14,7 @@
 ----------------------------------------------------------------------------*/
 inline REAL sum_naive  (const REAL *a, int n);
 inline REAL varm_naive (const REAL *a, int n, REAL m);
+inline void pivcnt_naive (const REAL *a, int n, REAL p, int *lt, int *eq);
 
 /*----------------------------------------------------------------------------
   Inline Functions
@@ -49,4 +50,22 @@ inline REAL varm_naive (const REAL *a, int n, REAL m)
   return v /= (REAL)(n-1);
 }  // varm_naive()
 
+/*--------------------------------------------------------------------------*/
+
+/* pivcnt_naive
+ * ------------
+ * count the values less than and equal to the pivot p
+ */
+inline void pivcnt_naive (const REAL *a, int n, REAL p, int *lt, int *eq)
+{
+  assert(a && (n > 0) && lt && eq);
+
+  int l = 0, e = 0;
+  for (int i = 0; i < n; i++) {
+    l += (a[i] <  p);
+    e += (a[i] == p);
+  }
+  *lt = l; *eq = e;
+}  // pivcnt_naive()
+
 #endif  // #ifndef STATS_NAIVE_REAL_H
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------------
+  File    : stats_par.c
+  Contents: thread-parallel reductions of very large arrays
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <limits.h>
+#include "stats_par.h"
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define PAR_SUM      0          // reductions computed per block
+#define PAR_VARM     1
+#define PAR_MEANVAR  2
+#define PAR_COPY     3
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static int nblocks (size_t n)
+{                               // --- number of blocks
+  size_t nb = (n + PAR_BLOCK-1) / PAR_BLOCK;
+  assert(nb <= INT_MAX);
+  return (int)nb;
+}  // nblocks()
+
+/*--------------------------------------------------------------------------*/
+
+static size_t cnt (size_t n, int b, int k)
+{                               // --- number of values in the blocks
+  size_t beg = (size_t)b * PAR_BLOCK;   //     b, ..., b+k-1
+  size_t end = (size_t)(b+k) * PAR_BLOCK;
+  return ((end < n) ? end : n) - beg;
+}  // cnt()
+
+/*--------------------------------------------------------------------------*/
+
+static double treesum (double *s, int nb)
+{                               // --- combine partial sums
+  for (int w = 1; w < nb; w *= 2)
+    for (int i = 0; i+w < nb; i += 2*w)
+      s[i] += s[i+w];           // (fixed pairwise order)
+  return s[0];
+}  // treesum()
+
+/*--------------------------------------------------------------------------*/
+
+static double treemv (double *s, double *q, int nb, size_t n)
+{                               // --- combine partial sums and sums of
+  for (int w = 1; w < nb; w *= 2) {     // squared deviations
+    for (int i = 0; i+w < nb; i += 2*w) {
+      double ni = (double)cnt(n, i,   w);
+      double nj = (double)cnt(n, i+w, w);
+      double d  = s[i]/ni - s[i+w]/nj;
+      q[i] += q[i+w] + d*d * (ni*nj/(ni+nj));
+      s[i] += s[i+w];           // (update of Chan et al., applied
+    }                           // in a fixed pairwise order)
+  }
+  return s[0];
+}  // treemv()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL      float         // (re)define REAL to be float
+#define psum      spsum
+#define pvarm     spvarm
+#define pmeanvar  spmeanvar
+#define pcopy     spcopy
+#define parjob    sparjob
+#define partask   spartask
+#define parssq    sparssq
+#define parrun    sparrun
+#include "def-or-undef-functions.inc"
+#include "stats_par_real.c"     // single precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef psum
+#undef pvarm
+#undef pmeanvar
+#undef pcopy
+#undef parjob
+#undef partask
+#undef parssq
+#undef parrun
+/*--------------------------------------------------------------------------*/
+#define REAL      double        // (re)define REAL to be double
+#define psum      dpsum
+#define pvarm     dpvarm
+#define pmeanvar  dpmeanvar
+#define pcopy     dpcopy
+#define parjob    dparjob
+#define partask   dpartask
+#define parssq    dparssq
+#define parrun    dparrun
+#include "def-or-undef-functions.inc"
+#include "stats_par_real.c"     // double precision versions
+#undef REAL
+#include "def-or-undef-functions.inc"
+#undef psum
+#undef pvarm
+#undef pmeanvar
+#undef pcopy
+#undef parjob
+#undef partask
+#undef parssq
+#undef parrun
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------
+  File    : stats_par.h
+  Contents: thread-parallel reductions of very large arrays
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_PAR_H
+#define STATS_PAR_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+#include "stats.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define PAR_BLOCK  65536        // number of values per block
+// The arrays are split into blocks of PAR_BLOCK values (the last block may
+// be shorter). Each block is reduced with the (SIMD) implementation
+// selected by stats_set_impl() and the partial results are combined in
+// double precision in a fixed (pairwise) tree order. Hence the results only
+// depend on the data, the block size and the selected implementation, but
+// not on the number of threads or the scheduling.
+//
+// The blocks are assigned to the threads as contiguous ranges (see
+// stats_parfor()). To have each thread read from its local NUMA node, the
+// input pages should be first touched by the thread that later reduces
+// them, e.g., by filling the array with pcopy() using the same number of
+// threads, and the worker threads should be pinned (see stats_pin()).
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* psum
+ * ----
+ * sum of the n values in a (thread-parallel)
+ *
+ * nthreads  number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * the sum; NaN if memory allocation failed
+ */
+extern float  spsum     (const float  *a, size_t n, int nthreads);
+extern double dpsum     (const double *a, size_t n, int nthreads);
+
+/* pvarm
+ * -----
+ * sample variance of the n values in a given their mean m
+ * (thread-parallel, n > 1)
+ *
+ * returns
+ * the variance; NaN if memory allocation failed
+ */
+extern float  spvarm    (const float  *a, size_t n, float  m,
+                         int nthreads);
+extern double dpvarm    (const double *a, size_t n, double m,
+                         int nthreads);
+
+/* pmeanvar
+ * --------
+ * mean and sample variance of the n values in a in a single pass
+ * (thread-parallel, n > 1)
+ *
+ * The per-block means and sums of squared deviations are combined with
+ * the pairwise update of Chan et al.
+ *
+ * var  buffer for the variance (may be NULL)
+ *
+ * returns
+ * the mean; NaN if memory allocation failed
+ */
+extern float  spmeanvar (const float  *a, size_t n, float  *var,
+                         int nthreads);
+extern double dpmeanvar (const double *a, size_t n, double *var,
+                         int nthreads);
+
+/* pcopy
+ * -----
+ * copy n values from src to dst (thread-parallel)
+ *
+ * The pages of dst are first touched by the threads that process them
+ * in the reductions above (for the same number of threads).
+ */
+extern void   spcopy    (float  *dst, const float  *src, size_t n,
+                         int nthreads);
+extern void   dpcopy    (double *dst, const double *src, size_t n,
+                         int nthreads);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define psum      dpsum
+#    define pvarm     dpvarm
+#    define pmeanvar  dpmeanvar
+#    define pcopy     dpcopy
+#  else
+#    define psum      spsum
+#    define pvarm     spvarm
+#    define pmeanvar  spmeanvar
+#    define pcopy     spcopy
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_PAR_H
@@ -0,0 +1,132 @@
+/*----------------------------------------------------------------------------
+  File    : stats_par_real.c
+  Contents: this file is to be included from stats_par.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- job for the thread-parallel loop
+  int        what;              // reduction (PAR_SUM, PAR_VARM, ...)
+  const REAL *a;                // data
+  REAL       *d;                // destination (PAR_COPY)
+  size_t     n;                 // number of values
+  REAL       m;                 // mean (PAR_VARM)
+  double     *s;                // partial sums
+  double     *q;                // partial sums of squared deviations
+} parjob;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static double parssq (const REAL *a, int n, REAL m)
+{                               // --- sum of squared deviations from m
+  if (n > 1)                    //     (using the selected implementation)
+    return (double)varm(a, n, m) * (double)(n-1);
+  return (double)(a[0]-m) * (double)(a[0]-m);
+}  // parssq()
+
+/*--------------------------------------------------------------------------*/
+
+static void partask (void *data, int tid, int beg, int end)
+{                               // --- reduce a range of blocks
+  parjob *j = (parjob*)data;
+  for (int b = beg; b < end; b++) {
+    size_t     off = (size_t)b * PAR_BLOCK;
+    int        len = (int)cnt(j->n, b, 1);
+    const REAL *a  = j->a + off;
+    switch (j->what) {
+      case PAR_SUM:
+        j->s[b] = (double)sum(a, len); break;
+      case PAR_VARM:
+        j->q[b] = parssq(a, len, j->m); break;
+      case PAR_MEANVAR: {
+        double s = (double)sum(a, len);
+        REAL   m = (REAL)(s / len);
+        double e = s/len - (double)m; // (correct for the rounding of m)
+        j->s[b] = s;
+        j->q[b] = parssq(a, len, m) - (double)len*e*e;
+        break; }
+      default: {                // PAR_COPY
+        REAL *d = j->d + off;
+        for (int i = 0; i < len; i++)
+          d[i] = a[i];
+        break; }
+    }
+  }
+}  // partask()
+
+/*--------------------------------------------------------------------------*/
+
+static int parrun (parjob *j, int nthreads)
+{                               // --- run a reduction
+  int nb = nblocks(j->n);
+  j->s = j->q = NULL;
+  if (nb == 0) return 0;        // (nothing to do)
+  if ((j->what != PAR_COPY)
+  &&  !(j->s = (double*) malloc((size_t)nb * 2*sizeof(double))))
+    return -1;                  // buffer for the partial results
+  if (j->s) j->q = j->s + nb;
+  stats_parfor(nthreads, nb, partask, j);
+  return nb;
+}  // parrun()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+REAL psum (const REAL *a, size_t n, int nthreads)
+{
+  assert(a);
+
+  parjob j = { .what = PAR_SUM, .a = a, .n = n };
+  int nb = parrun(&j, nthreads);
+  if (nb < 0) return (REAL)NAN;
+  double s = (nb > 0) ? treesum(j.s, nb) : 0;
+  free(j.s);
+  return (REAL)s;
+}  // psum()
+
+/*--------------------------------------------------------------------------*/
+
+REAL pvarm (const REAL *a, size_t n, REAL m, int nthreads)
+{
+  assert(a && (n > 1));
+
+  parjob j = { .what = PAR_VARM, .a = a, .n = n, .m = m };
+  int nb = parrun(&j, nthreads);
+  if (nb < 0) return (REAL)NAN;
+  double q = treesum(j.q, nb);
+  free(j.s);
+  return (REAL)(q / (double)(n-1));
+}  // pvarm()
+
+/*--------------------------------------------------------------------------*/
+
+REAL pmeanvar (const REAL *a, size_t n, REAL *var, int nthreads)
+{
+  assert(a && (n > 1));
+
+  parjob j = { .what = PAR_MEANVAR, .a = a, .n = n };
+  int nb = parrun(&j, nthreads);
+  if (nb < 0) {
+    if (var) *var = (REAL)NAN;
+    return (REAL)NAN;
+  }
+  double s = treemv(j.s, j.q, nb, n);
+  if (var) *var = (REAL)(j.q[0] / (double)(n-1));
+  free(j.s);
+  return (REAL)(s / (double)n);
+}  // pmeanvar()
+
+/*--------------------------------------------------------------------------*/
+
+void pcopy (REAL *dst, const REAL *src, size_t n, int nthreads)
+{
+  assert(dst && src);
+
+  parjob j = { .what = PAR_COPY, .a = src, .d = dst, .n = n };
+  parrun(&j, nthreads);
+}  // pcopy()
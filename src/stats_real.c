@@ -21,12 +21,42 @@ extern REAL tstat     (const REAL *a, int n);
 extern REAL mdiff     (const REAL *x1, const REAL *x2, int n1, int n2);
 extern REAL tstat2    (const REAL *x1, const REAL *x2, int n1, int n2);
 extern tres welcht    (const REAL *x1, const REAL *x2, int n1, int n2);
+
+// two samples, prepared groups
+extern grp  grpinit   (const REAL *a, int n);
+extern REAL tstat2p   (const grp *g1, const grp *g2);
+extern REAL tstat2r   (const REAL *x1, int n1, const grp *g2);
+extern void tstat2b   (const REAL *X, int n1, int m, const grp *g2, REAL *t);
+extern tres welchtp   (const grp *g1, const grp *g2);
+extern tres welchtr   (const REAL *x1, int n1, const grp *g2);
+extern void welchtb   (const REAL *X, int n1, int m, const grp *g2,
+                       REAL *t, REAL *df);
 extern REAL pairedt   (const REAL *x1, const REAL *x2, int n);
 
 // difference-in-differences
 extern REAL didt      (const REAL *x1, const REAL *x2,
                        const REAL *y1, const REAL *y2, int nx, int ny);
 
+// rank-based tests
+extern REAL ranks     (const REAL *a, int n, REAL *r);
+extern REAL ranksum   (const REAL *x1, const REAL *x2, int n1, int n2);
+extern REAL signrank  (const REAL *x1, const REAL *x2, int n);
+
+// order statistics and trimmed means
+extern REAL qselect   (const REAL *a, int n, int k, REAL *buf);
+extern REAL quantile  (const REAL *a, int n, REAL p, REAL *buf);
+extern REAL median    (const REAL *a, int n, REAL *buf);
+extern REAL mad       (const REAL *a, int n, REAL *buf);
+extern REAL trmeanvar (const REAL *a, int n, REAL gamma, REAL *buf,
+                       REAL *wv);
+extern REAL trmean    (const REAL *a, int n, REAL gamma, REAL *buf);
+extern REAL winvar    (const REAL *a, int n, REAL gamma, REAL *buf);
+extern tres yuent     (const REAL *x1, const REAL *x2, int n1, int n2,
+                       REAL gamma, REAL *buf);
+
+// k samples
+extern REAL anova1    (const REAL *a, const int *n, int k);
+
 // wrappers (same signature across functions)
 extern REAL sum_w     (const REAL *a, const int *n);
 extern REAL mean_w    (const REAL *a, const int *n);
@@ -38,10 +68,24 @@ extern REAL mdiff_w   (const REAL *a, const int *n);
 extern REAL tstat2_w  (const REAL *a, const int *n);
 extern REAL pairedt_w (const REAL *a, const int *n);
 extern REAL didt_w    (const REAL *a, const int *n);
+extern REAL ranksum_w (const REAL *a, const int *n);
+extern REAL signrank_w(const REAL *a, const int *n);
+extern REAL anova1_w  (const REAL *a, const int *n);
 
 // permutation
 extern REAL perm      (const REAL *a, int *n, int ntotal, const int *prm,
                        int np, Func1 *func, REAL *tmp, REAL *s);
+extern REAL permv     (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, Func1 *func, int ties, REAL *tmp, REAL *s);
+extern REAL seqperm   (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, Func1 *func, int h, REAL alpha,
+                       REAL *tmp, REAL *s, int *used);
+extern REAL rankperm  (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, REAL *tmp, REAL *s);
+extern REAL signperm  (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, REAL *tmp, REAL *s);
+extern REAL anova1perm(const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, REAL *tmp, REAL *s);
 
 // Fisher r-to-z transform
 extern REAL fr2z      (const REAL r);
@@ -51,6 +95,7 @@ extern REAL fr2z      (const REAL r);
 ----------------------------------------------------------------------------*/
 sum_func  *sum_ptr  = &sum_select;
 varm_func *varm_ptr = &varm_select;
+pivcnt_func *pivcnt_ptr = &pivcnt_select;
 
 /*----------------------------------------------------------------------------
   Functions
@@ -69,3 +114,11 @@ REAL varm_select (const REAL *a, int n, REAL m)
   stats_set_impl(STATS_AUTO);
   return (*varm_ptr)(a,n,m);
 }  // varm_select()
+
+/*--------------------------------------------------------------------------*/
+
+void pivcnt_select (const REAL *a, int n, REAL p, int *lt, int *eq)
+{
+  stats_set_impl(STATS_AUTO);
+  (*pivcnt_ptr)(a,n,p,lt,eq);
+}  // pivcnt_select()
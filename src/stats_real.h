@@ -7,7 +7,9 @@
 #define STATS_REAL_H
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
+#include <float.h>
 
 typedef REAL Func1    (const REAL* a, const int *n);
 
@@ -28,12 +30,42 @@ inline REAL tstat     (const REAL *a, int n);
 inline REAL mdiff     (const REAL *x1, const REAL *x2, int n1, int n2);
 inline REAL tstat2    (const REAL *x1, const REAL *x2, int n1, int n2);
 inline tres welcht    (const REAL *x1, const REAL *x2, int n1, int n2);
+
+// two samples, prepared groups
+inline grp  grpinit   (const REAL *a, int n);
+inline REAL tstat2p   (const grp *g1, const grp *g2);
+inline REAL tstat2r   (const REAL *x1, int n1, const grp *g2);
+inline void tstat2b   (const REAL *X, int n1, int m, const grp *g2, REAL *t);
+inline tres welchtp   (const grp *g1, const grp *g2);
+inline tres welchtr   (const REAL *x1, int n1, const grp *g2);
+inline void welchtb   (const REAL *X, int n1, int m, const grp *g2,
+                       REAL *t, REAL *df);
 inline REAL pairedt   (const REAL *x1, const REAL *x2, int n);
 
 // difference-in-differences
 inline REAL didt      (const REAL *x1, const REAL *x2,
                        const REAL *y1, const REAL *y2, int nx, int ny);
 
+// rank-based tests
+inline REAL ranks     (const REAL *a, int n, REAL *r);
+inline REAL ranksum   (const REAL *x1, const REAL *x2, int n1, int n2);
+inline REAL signrank  (const REAL *x1, const REAL *x2, int n);
+
+// order statistics and trimmed means
+inline REAL qselect   (const REAL *a, int n, int k, REAL *buf);
+inline REAL quantile  (const REAL *a, int n, REAL p, REAL *buf);
+inline REAL median    (const REAL *a, int n, REAL *buf);
+inline REAL mad       (const REAL *a, int n, REAL *buf);
+inline REAL trmeanvar (const REAL *a, int n, REAL gamma, REAL *buf,
+                       REAL *wv);
+inline REAL trmean    (const REAL *a, int n, REAL gamma, REAL *buf);
+inline REAL winvar    (const REAL *a, int n, REAL gamma, REAL *buf);
+inline tres yuent     (const REAL *x1, const REAL *x2, int n1, int n2,
+                       REAL gamma, REAL *buf);
+
+// k samples
+inline REAL anova1    (const REAL *a, const int *n, int k);
+
 // wrappers (same signature across functions)
 inline REAL sum_w     (const REAL *a, const int *n);
 inline REAL mean_w    (const REAL *a, const int *n);
@@ -45,10 +77,24 @@ inline REAL mdiff_w   (const REAL *a, const int *n);
 inline REAL tstat2_w  (const REAL *a, const int *n);
 inline REAL pairedt_w (const REAL *a, const int *n);
 inline REAL didt_w    (const REAL *a, const int *n);
+inline REAL ranksum_w (const REAL *a, const int *n);
+inline REAL signrank_w(const REAL *a, const int *n);
+inline REAL anova1_w  (const REAL *a, const int *n);
 
 // permutation
 inline REAL perm      (const REAL *a, int *n, int ntotal, const int *prm,
                        int np, Func1 *func, REAL *tmp, REAL *s);
+inline REAL permv     (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, Func1 *func, int ties, REAL *tmp, REAL *s);
+inline REAL seqperm   (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, Func1 *func, int h, REAL alpha,
+                       REAL *tmp, REAL *s, int *used);
+inline REAL rankperm  (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, REAL *tmp, REAL *s);
+inline REAL signperm  (const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, REAL *tmp, REAL *s);
+inline REAL anova1perm(const REAL *a, int *n, int ntotal, const int *prm,
+                       int np, REAL *tmp, REAL *s);
 
 // Fisher r-to-z transform
 inline REAL fr2z      (const REAL r);
@@ -239,6 +285,115 @@ inline tres welcht (const REAL *x1, const REAL *x2, int n1, int n2)
 
 /*--------------------------------------------------------------------------*/
 
+/* grpinit
+ * -------
+ * prepare a group for repeated two-sample comparisons
+ *
+ * The size, the mean and the sum of squared deviations from the mean (M2)
+ * of the group are computed once. Comparisons against the prepared group
+ * (e.g., a fixed control group, see tstat2r(), welchtr() and the batched
+ * forms tstat2b() and welchtb()) then only process the other sample.
+ */
+inline grp grpinit (const REAL *a, int n)
+{
+  assert(a && (n > 1));
+
+  REAL m = mean(a, n);
+  grp  g = { .n = n, .m = m, .m2 = varm(a, n, m) * (REAL)(n-1) };
+  return g;
+}  // grpinit()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL tstat2p (const grp *g1, const grp *g2)
+{
+  assert(g1 && g2 && (g1->n > 1) && (g2->n > 1));
+
+  REAL md = g1->m - g2->m;     // mean difference
+  REAL df = (REAL)g1->n + (REAL)g2->n - 2;  // degrees of freedom
+
+  return md / ( sqrt( (g1->m2 + g2->m2) / df )
+                * sqrt(1/(REAL)g1->n + 1/(REAL)g2->n) );
+}  // tstat2p()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL tstat2r (const REAL *x1, int n1, const grp *g2)
+{
+  assert(x1 && (n1 > 1) && g2);
+
+  grp g1 = grpinit(x1, n1);
+  return tstat2p(&g1, g2);
+}  // tstat2r()
+
+/*--------------------------------------------------------------------------*/
+
+/* tstat2b
+ * -------
+ * two-sample t tests of many samples against a prepared group
+ *
+ * X   samples (n1 x m, column-major, i.e., one sample per column)
+ * t   buffer for the m t statistics
+ */
+inline void tstat2b (const REAL *X, int n1, int m, const grp *g2, REAL *t)
+{
+  assert(X && (n1 > 1) && (m >= 0) && g2 && t);
+
+  for (int v = 0; v < m; v++)
+    t[v] = tstat2r(X + (size_t)v*(size_t)n1, n1, g2);
+}  // tstat2b()
+
+/*--------------------------------------------------------------------------*/
+
+inline tres welchtp (const grp *g1, const grp *g2)
+{
+  assert(g1 && g2 && (g1->n > 1) && (g2->n > 1));
+
+  REAL n1f = (REAL)g1->n;
+  REAL n2f = (REAL)g2->n;
+  REAL v1  = g1->m2 / (n1f-1);       // sample variances
+  REAL v2  = g2->m2 / (n2f-1);
+  REAL df  = ((v1/n1f + v2/n2f) * (v1/n1f + v2/n2f))
+               / ((v1*v1)/(n1f*n1f*(n1f-1)) + (v2*v2)/(n2f*n2f*(n2f-1)));
+  tres res = { .t = (g1->m - g2->m) / sqrt(v1/n1f + v2/n2f),
+               .df = df };
+  return res;
+}  // welchtp()
+
+/*--------------------------------------------------------------------------*/
+
+inline tres welchtr (const REAL *x1, int n1, const grp *g2)
+{
+  assert(x1 && (n1 > 1) && g2);
+
+  grp g1 = grpinit(x1, n1);
+  return welchtp(&g1, g2);
+}  // welchtr()
+
+/*--------------------------------------------------------------------------*/
+
+/* welchtb
+ * -------
+ * Welch's t tests of many samples against a prepared group
+ *
+ * X   samples (n1 x m, column-major, i.e., one sample per column)
+ * t   buffer for the m t statistics
+ * df  buffer for the m degrees of freedom (may be NULL)
+ */
+inline void welchtb (const REAL *X, int n1, int m, const grp *g2,
+                     REAL *t, REAL *df)
+{
+  assert(X && (n1 > 1) && (m >= 0) && g2 && t);
+
+  for (int v = 0; v < m; v++) {
+    tres r = welchtr(X + (size_t)v*(size_t)n1, n1, g2);
+    t[v] = r.t;
+    if (df) df[v] = r.df;
+  }
+}  // welchtb()
+
+/*--------------------------------------------------------------------------*/
+
 inline REAL pairedt (const REAL *x1, const REAL *x2, int n)
 {
   assert(x1 && x2 && (n > 1));
@@ -311,6 +466,459 @@ inline REAL didt_w (const REAL *a, const int *n)
 
 /*--------------------------------------------------------------------------*/
 
+/* ranks
+ * -----
+ * compute the ranks of the values in a (mid-ranks for ties, 1-based)
+ *
+ * For n <= RANKS_DIRECT, the rank of each value is obtained by comparing
+ * it to all values in a branch-free loop that is vectorized by the
+ * compiler; for larger n, the values are sorted (heapsort).
+ *
+ * r       buffer for the n ranks
+ *
+ * returns
+ * the tie term sum(t^3-t) over all groups of t tied values
+ */
+inline REAL ranks (const REAL *a, int n, REAL *r)
+{
+  assert(a && (n > 0) && r);
+
+  double tt = 0;                     // tie term
+
+  REAL *v = NULL;
+  if (n > RANKS_DIRECT)
+    v = (REAL *) malloc((size_t)n *(sizeof(REAL) + sizeof(int)));
+  if (!v) {                          // rank by direct comparison
+    for (int i = 0; i < n; i++) {
+      REAL ai = a[i];
+      int  lt = 0, eq = 0;           // count the values less than and
+      for (int j = 0; j < n; j++) {  // equal to the current value
+        lt += (a[j] <  ai);
+        eq += (a[j] == ai);
+      }
+      r[i] = (REAL)lt + (REAL)(eq+1) * (REAL)0.5;
+      tt  += (double)eq*(double)eq - 1;
+    }                                // each value of a tie group of size
+    return (REAL)tt;                 // t contributes t^2-1 to the term
+  }
+
+  int *ix = (int *)(v + n);          // rank by sorting
+  for (int i = 0; i < n; i++) {
+    v[i] = a[i]; ix[i] = i; }
+  for (int k = n/2, m = n; m > 1; ) {  // heapsort (values and indices)
+    if (k > 0) k--;
+    else { m--;
+      REAL tv = v[0]; v[0] = v[m]; v[m] = tv;
+      int  ti = ix[0]; ix[0] = ix[m]; ix[m] = ti;
+    }
+    REAL x = v[k]; int xi = ix[k];
+    int  i = k, c;
+    while ((c = 2*i+1) < m) {        // sift down
+      if ((c+1 < m) && (v[c+1] > v[c])) c++;
+      if (v[c] <= x) break;
+      v[i] = v[c]; ix[i] = ix[c]; i = c;
+    }
+    v[i] = x; ix[i] = xi;
+  }
+  for (int i = 0, j; i < n; i = j) { // traverse the tie groups
+    for (j = i+1; (j < n) && (v[j] == v[i]); j++);
+    REAL rk = (REAL)(i+1 + j) * (REAL)0.5;
+    for (int k = i; k < j; k++)
+      r[ix[k]] = rk;                 // assign the mid-rank
+    double t = (double)(j-i);
+    tt += t*t*t - t;
+  }
+  free(v);
+  return (REAL)tt;
+}  // ranks()
+
+/*--------------------------------------------------------------------------*/
+
+/* ranksum
+ * -------
+ * Wilcoxon rank sum / Mann-Whitney U test
+ *
+ * returns
+ * the z score of U = R1 - n1(n1+1)/2 (normal approximation, corrected
+ * for ties, no continuity correction); positive if x1 tends to be larger;
+ * NaN if memory allocation failed
+ */
+inline REAL ranksum (const REAL *x1, const REAL *x2, int n1, int n2)
+{
+  assert(x1 && x2 && (n1 > 0) && (n2 > 0));
+
+  int  nt = n1 + n2;
+  REAL *a = (REAL *) malloc((size_t)(2*nt) *sizeof(REAL));
+  if (!a) return (REAL)NAN;          // (memory allocation failed)
+  REAL *r = a + nt;
+  memcpy(a,    x1, (size_t)n1 *sizeof(REAL));
+  memcpy(a+n1, x2, (size_t)n2 *sizeof(REAL));
+  double tt = (double)ranks(a, nt, r);
+  double r1 = 0;                     // rank sum of sample #1
+  for (int i = 0; i < n1; i++)
+    r1 += (double)r[i];
+  free(a);
+
+  double N  = (double)nt;
+  double u  = r1 - (double)n1*((double)n1+1)/2;
+  double mu = (double)n1*(double)n2/2;
+  REAL   sd = sqrt((REAL)((double)n1*(double)n2/12 * ((N+1) - tt/(N*(N-1)))));
+  return (sd > 0) ? (REAL)(u - mu)/sd : 0;
+}  // ranksum()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL ranksum_w (const REAL *a, const int *n)
+{
+  assert(a && n);
+
+  return ranksum(a, a+n[0], n[0], n[1]);
+}  // ranksum_w()
+
+/*--------------------------------------------------------------------------*/
+
+/* signrank
+ * --------
+ * Wilcoxon signed rank test
+ *
+ * Zero differences are discarded.
+ *
+ * returns
+ * the z score of W+ (sum of the ranks of the positive differences x1-x2;
+ * normal approximation, corrected for ties, no continuity correction);
+ * NaN if memory allocation failed
+ */
+inline REAL signrank (const REAL *x1, const REAL *x2, int n)
+{
+  assert(x1 && x2 && (n > 0));
+
+  REAL *d = (REAL *) malloc((size_t)(3*n) *sizeof(REAL));
+  if (!d) return (REAL)NAN;          // (memory allocation failed)
+  REAL *sd = d  + n;                 // signed differences
+  REAL *r  = sd + n;                 // ranks of the absolute differences
+  int  m   = 0;                      // number of nonzero differences
+  for (int i = 0; i < n; i++) {
+    REAL di = x1[i] - x2[i];
+    if (di != 0) { sd[m] = di; d[m] = (di < 0) ? -di : di; m++; }
+  }
+  double w = 0, tt = 0;
+  if (m > 0) {
+    tt = (double)ranks(d, m, r);
+    for (int i = 0; i < m; i++)      // sum up the ranks of the
+      if (sd[i] > 0)                 // positive differences
+        w += (double)r[i];
+  }
+  free(d);
+  if (m == 0) return 0;
+
+  double M  = (double)m;
+  double mu = M*(M+1)/4;
+  REAL   sw = sqrt((REAL)(M*(M+1)*(2*M+1)/24 - tt/48));
+  return (sw > 0) ? (REAL)(w - mu)/sw : 0;
+}  // signrank()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL signrank_w (const REAL *a, const int *n)
+{
+  assert(a && n);
+
+  return signrank(a, a+n[0], n[0]);
+}  // signrank_w()
+
+/*--------------------------------------------------------------------------*/
+
+/* qselect
+ * -------
+ * select the k-th smallest value (k = 0, ..., n-1) without sorting
+ *
+ * In each step, the values less than and equal to a pivot are counted
+ * with the pivcnt kernel of the selected set of implementations (see
+ * stats_set_impl()). The search stops if the k-th value equals the
+ * pivot; otherwise only the values on the side that contains it are
+ * kept (compacted into buf without branches). The pivot is the median of
+ * three pseudo-randomly chosen values. Parts of at most 16 values, and
+ * parts that have not become small after 64 steps, are sorted (heapsort).
+ * a must not contain NaNs.
+ *
+ * buf     buffer for n values (may be a, which is then overwritten)
+ */
+inline REAL qselect (const REAL *a, int n, int k, REAL *buf)
+{
+  assert(a && (n > 0) && (k >= 0) && (k < n) && buf);
+
+  const REAL *src = a;               // values of the current part
+  unsigned int rs = (unsigned int)n * 2654435761u;  // state of xorshift32
+  for (int it = 0; (n > 16) && (it < 64); it++) {
+    REAL c[3];                       // choose the pivot
+    for (int j = 0; j < 3; j++) {
+      rs ^= rs << 13; rs ^= rs >> 17; rs ^= rs << 5;
+      c[j] = src[rs % (unsigned int)n];
+    }
+    REAL p = (c[0] < c[1])
+           ? ((c[1] < c[2]) ? c[1] : (c[0] < c[2]) ? c[2] : c[0])
+           : ((c[0] < c[2]) ? c[0] : (c[1] < c[2]) ? c[2] : c[1]);
+
+    int lt, eq;                      // count the values less than and
+    (*pivcnt_ptr)(src, n, p, &lt, &eq);  // equal to the pivot
+    if ((k >= lt) && (k < lt+eq))
+      return p;
+
+    int m = 0;                       // (m <= i, so src may be buf)
+    if (k < lt) {                    // keep the values below the pivot
+      for (int i = 0; i < n; i++) {
+        REAL x = src[i]; buf[m] = x; m += (x < p); }
+    }
+    else {                           // keep the values above the pivot
+      for (int i = 0; i < n; i++) {
+        REAL x = src[i]; buf[m] = x; m += (x > p); }
+      k -= lt+eq;
+    }
+    src = buf; n = m;
+  }
+
+  REAL *v = buf;                     // sort the remaining values
+  if (src != buf)
+    for (int i = 0; i < n; i++)
+      v[i] = src[i];
+  for (int h = n/2, m = n; m > 1; ) {  // heapsort
+    REAL x;
+    if (h > 0) x = v[--h];
+    else { m--; x = v[m]; v[m] = v[0]; }
+    int i = h, c;
+    while ((c = 2*i+1) < m) {        // sift down
+      if ((c+1 < m) && (v[c+1] > v[c])) c++;
+      if (v[c] <= x) break;
+      v[i] = v[c]; i = c;
+    }
+    v[i] = x;
+  }
+  return v[k];
+}  // qselect()
+
+/*--------------------------------------------------------------------------*/
+
+/* quantile
+ * --------
+ * compute the p-quantile (linear interpolation between the order
+ * statistics x_(floor(h)) and x_(floor(h)+1), h = p*(n-1), 0-based)
+ *
+ * The lower order statistic is found with qselect(); the upper one is
+ * either equal to it (ties) or the smallest value above it, which takes
+ * one more pass over a.
+ *
+ * buf     buffer for n values (must not overlap with a)
+ */
+inline REAL quantile (const REAL *a, int n, REAL p, REAL *buf)
+{
+  assert(a && (n > 0) && (p >= 0) && (p <= 1) && buf);
+
+  double h = (double)p * (double)(n-1);
+  int    i = (int)h;
+  if (i >= n-1)
+    return qselect(a, n, n-1, buf);
+  REAL lo = qselect(a, n, i, buf);
+  if (h == (double)i)
+    return lo;
+
+  int  le = 0;                       // count the values <= lo and find
+  REAL hi = (REAL)INFINITY;          // the smallest value above lo
+  for (int j = 0; j < n; j++) {
+    le += (a[j] <= lo);
+    hi  = ((a[j] > lo) && (a[j] < hi)) ? a[j] : hi;
+  }
+  if (le > i+1) hi = lo;
+  return lo + (REAL)(h - (double)i) * (hi - lo);
+}  // quantile()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL median (const REAL *a, int n, REAL *buf)
+{
+  assert(a && (n > 0) && buf);
+
+  return quantile(a, n, (REAL)0.5, buf);
+}  // median()
+
+/*--------------------------------------------------------------------------*/
+
+/* mad
+ * ---
+ * compute the median absolute deviation from the median (unscaled)
+ *
+ * buf     buffer for 2*n values
+ */
+inline REAL mad (const REAL *a, int n, REAL *buf)
+{
+  assert(a && (n > 0) && buf);
+
+  REAL m = median(a, n, buf);
+  for (int i = 0; i < n; i++)
+    buf[i] = (a[i] < m) ? m - a[i] : a[i] - m;
+  return median(buf, n, buf+n);
+}  // mad()
+
+/*--------------------------------------------------------------------------*/
+
+/* trmeanvar
+ * ---------
+ * compute the trimmed mean and the winsorized variance
+ *
+ * g = floor(gamma*n) values are removed (trimmed mean) or replaced by
+ * the nearest remaining value (winsorized variance) at each end. The
+ * order statistics x_(g) and x_(n-g-1) are found with qselect(); ties
+ * with these bounds are then resolved by counting, so a is traversed
+ * once more for the trimmed mean and twice for the winsorized variance.
+ *
+ * gamma   proportion of values to trim at each end (0 <= gamma < 0.5)
+ * buf     buffer for n values (must not overlap with a)
+ * wv      where to store the winsorized variance, or NULL (n > 1)
+ *
+ * returns
+ * the trimmed mean
+ */
+inline REAL trmeanvar (const REAL *a, int n, REAL gamma, REAL *buf,
+                       REAL *wv)
+{
+  assert(a && (n > 0) && (gamma >= 0) && (gamma < 0.5) && buf);
+
+  int  g  = (int)((double)gamma * (double)n);
+  REAL lo = qselect(a, n, g, buf);
+  REAL hi = qselect(a, n, n-g-1, buf);
+  if (lo == hi) {                    // (all retained values are equal)
+    if (wv) *wv = 0;
+    return lo;
+  }
+
+  int  nlo = 0, nhi = 0;             // number of values <= lo and < hi
+  REAL s   = 0;                      // sum of the values in (lo,hi)
+  for (int i = 0; i < n; i++) {
+    nlo += (a[i] <= lo);
+    nhi += (a[i] <  hi);
+    s   += ((a[i] > lo) && (a[i] < hi)) ? a[i] : 0;
+  }
+  REAL tm = (s + (REAL)(nlo-g)*lo + (REAL)(n-g-nhi)*hi) /(REAL)(n-2*g);
+
+  if (wv) {                          // winsorized variance
+    assert(n > 1);
+    REAL wm = (s + (REAL)nlo*lo + (REAL)(n-nhi)*hi) /(REAL)n;
+    REAL v  = 0;
+    for (int i = 0; i < n; i++) {
+      REAL x = (a[i] < lo) ? lo : (a[i] > hi) ? hi : a[i];
+      v += (x - wm)*(x - wm);
+    }
+    *wv = v /(REAL)(n-1);
+  }
+  return tm;
+}  // trmeanvar()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL trmean (const REAL *a, int n, REAL gamma, REAL *buf)
+{
+  assert(a && (n > 0) && buf);
+
+  return trmeanvar(a, n, gamma, buf, NULL);
+}  // trmean()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL winvar (const REAL *a, int n, REAL gamma, REAL *buf)
+{
+  assert(a && (n > 1) && buf);
+
+  REAL v;
+  trmeanvar(a, n, gamma, buf, &v);
+  return v;
+}  // winvar()
+
+/*--------------------------------------------------------------------------*/
+
+/* yuent
+ * -----
+ * Yuen's two-sample t test for trimmed means (unequal variances)
+ *
+ * With h_i = n_i - 2 floor(gamma*n_i) retained values and the winsorized
+ * variances s_i^2, d_i = (n_i-1) s_i^2 / (h_i (h_i-1)),
+ * t  = (trimmed mean 1 - trimmed mean 2) / sqrt(d_1 + d_2) and
+ * df = (d_1 + d_2)^2 / (d_1^2/(h_1-1) + d_2^2/(h_2-1)).
+ *
+ * gamma   proportion of values to trim at each end (e.g., 0.2)
+ * buf     buffer for max(n1,n2) values
+ */
+inline tres yuent (const REAL *x1, const REAL *x2, int n1, int n2,
+                   REAL gamma, REAL *buf)
+{
+  assert(x1 && x2 && (n1 > 1) && (n2 > 1) && buf);
+
+  REAL w1, w2;                       // trimmed means and
+  REAL m1 = trmeanvar(x1, n1, gamma, buf, &w1);  // winsorized variances
+  REAL m2 = trmeanvar(x2, n2, gamma, buf, &w2);
+  REAL h1 = (REAL)(n1 - 2*(int)((double)gamma * (double)n1));
+  REAL h2 = (REAL)(n2 - 2*(int)((double)gamma * (double)n2));
+  assert((h1 > 1) && (h2 > 1));
+  REAL d1 = (REAL)(n1-1) * w1 / (h1*(h1-1));
+  REAL d2 = (REAL)(n2-1) * w2 / (h2*(h2-1));
+  REAL df = ((d1 + d2) * (d1 + d2))
+              / (d1*d1/(h1-1) + d2*d2/(h2-1));
+  tres res = { .t = (m1 - m2) / sqrt(d1 + d2), .df = df };
+  return res;
+}  // yuent()
+
+/*--------------------------------------------------------------------------*/
+
+/* anova1
+ * ------
+ * one-way analysis of variance (F statistic)
+ *
+ * The k samples are stored contiguously in a (n[0] values of sample #1,
+ * followed by n[1] values of sample #2, ...). The sums and sums of
+ * squares of all samples are computed in a single pass over the data
+ * (shifted by a[0] to reduce cancellation).
+ *
+ * returns
+ * the F statistic with df = (k-1, ntotal-k)
+ */
+inline REAL anova1 (const REAL *a, const int *n, int k)
+{
+  assert(a && n && (k > 1));
+
+  REAL c  = a[0];                    // shift
+  REAL sb = 0, sw = 0;               // between and within sums of squares
+  REAL t  = 0;                       // total sum
+  int  nt = 0;                       // total number of values
+  for (int g = 0; g < k; g++) {      // for each sample
+    assert(n[g] > 0);
+    const REAL *x = a + nt;
+    REAL s = 0, q = 0;               // sum and sum of squares
+    for (int i = 0; i < n[g]; i++) {
+      REAL d = x[i] - c;
+      s += d;
+      q += d*d;
+    }
+    sb += s*s/(REAL)n[g];
+    sw += q - s*s/(REAL)n[g];
+    t  += s;
+    nt += n[g];
+  }
+  sb -= t*t/(REAL)nt;
+
+  return (sb/(REAL)(k-1)) / (sw/(REAL)(nt-k));
+}  // anova1()
+
+/*--------------------------------------------------------------------------*/
+
+inline REAL anova1_w (const REAL *a, const int *n)
+{
+  assert(a && n);
+
+  int k = 0;                         // the list of sample sizes
+  while (n[k] > 0) k++;              // has to be terminated by 0
+  return anova1(a, n, k);
+}  // anova1_w()
+
+/*--------------------------------------------------------------------------*/
+
 /* perm
  * ----
  *
@@ -319,6 +927,7 @@ inline REAL didt_w (const REAL *a, const int *n)
  * n       n[0] - number of data sets in sample #1
  *         n[1] - number of data sets in sample #2
  *         ...  - ...
+ *         (terminated by 0 for anova1_w)
  *
  * ntotal  total number of data sets
  *
@@ -329,7 +938,10 @@ inline REAL didt_w (const REAL *a, const int *n)
  *
  * np      number of permutations
  *
- * func    mdiff_w, tstat2_w, pairedt_w, didt_w
+ * func    mdiff_w, tstat2_w, pairedt_w, didt_w, ranksum_w, signrank_w,
+ *         anova1_w
+ *         (for mdiff_w, tstat2_w and pairedt_w with ntotal <= PERMV_MAXN,
+ *         the permutations are evaluated in blocks, see permv())
  *
  * tmp     buffer for ntotal REAL values
  *
@@ -344,6 +956,10 @@ inline REAL perm (const REAL *a, int *n, int ntotal, const int *prm,
 {
   assert(a && n && prm && (np > 0) && func && tmp);
 
+  if (((func == mdiff_w) || (func == tstat2_w) || (func == pairedt_w))
+  &&  (ntotal <= PERMV_MAXN))
+    return permv(a, n, ntotal, prm, np, func, 0, tmp, s);
+
   REAL sval = func(a, n);                   // compute the statistic
   if (s)                                    // if s is not NULL,
     *s = sval;                              // store the statistic in it
@@ -361,6 +977,381 @@ inline REAL perm (const REAL *a, int *n, int ntotal, const int *prm,
 
 /*--------------------------------------------------------------------------*/
 
+/* seqperm
+ * -------
+ * sequential permutation test that stops as soon as the outcome is clear
+ *
+ * The permutations are evaluated in order, and the test stops early
+ *  - after h statistics were at least as extreme as the observed one
+ *    (Besag & Clifford, 1991): p = h/l, where l is the number of
+ *    permutations used so far, or
+ *  - as soon as the lower confidence bound cnt/l - sqrt(log(1/delta)/(2l))
+ *    on p (Hoeffding, delta = 0.001, see SEQPERM_LOGD) exceeds alpha,
+ *    i.e., the test is clearly not significant: p = (cnt+1)/(l+1).
+ * If neither happens, all np permutations are used and the p value is
+ * the same as that of perm().
+ * The remaining parameters are the same as for perm().
+ *
+ * h       number of exceedances after which to stop (<= 0 -> never)
+ *
+ * alpha   significance level for the confidence bound (<= 0 -> never)
+ *
+ * used    If a valid ptr is passed, it will be used to store the number
+ *         of permutations that were actually evaluated.
+ *
+ * returns
+ * p value
+ */
+inline REAL seqperm (const REAL *a, int *n, int ntotal, const int *prm,
+                     int np, Func1 *func, int h, REAL alpha,
+                     REAL *tmp, REAL *s, int *used)
+{
+  assert(a && n && prm && (np > 0) && func && tmp);
+
+  REAL sval = func(a, n);                   // compute the statistic
+  if (s)
+    *s = sval;
+  sval = (REAL)fabs(sval);
+
+  double c = SEQPERM_LOGD/2;                // (squared bound: c/l)
+  int cnt = 0, i = 0;
+  while (i < np) {
+    const int *pi = prm + (size_t)i*(size_t)ntotal;
+    for (int j = 0; j < ntotal; j++)        // shuffle the data
+      tmp[j] = a[pi[j]];
+    cnt += (fabs(func(tmp, n)) >= sval);
+    i++;
+    if ((h > 0) && (cnt >= h)) {            // enough exceedances
+      if (used) *used = i;
+      return (REAL)cnt/(REAL)i;
+    }
+    double d = (double)cnt - (double)alpha*(double)i;
+    if ((alpha > 0) && (d > 0) && (d*d > c*(double)i))
+      break;                                // p is clearly above alpha
+  }
+  if (used) *used = i;
+  return (REAL)(cnt + 1)/(REAL)(i + 1);
+}  // seqperm()
+
+/*--------------------------------------------------------------------------*/
+
+/* permv
+ * -----
+ * permutation test evaluating PERMV_LANES permutations at a time
+ *
+ * The parameters are the same as for perm(), with func = mdiff_w,
+ * tstat2_w or pairedt_w and ntotal <= PERMV_MAXN (perm() calls this
+ * function in that case, with ties = 0). A block of permutations is gathered into
+ * structure-of-arrays form (value j of permutation l at t[j*L+l], with
+ * L = PERMV_LANES), so that the group sums and the sums of squared
+ * deviations of all permutations in the block are accumulated in the
+ * lanes of the same vectors (branch-free loops over the lanes, which are
+ * vectorized by the compiler). The observed statistic is evaluated in the
+ * same way, and statistics are counted with the same (exact) comparison
+ * as in perm().
+ *
+ * ties    If nonzero, the data are centered (copied to tmp, minus their
+ *         mean) before the gathering, which keeps the rounding error of
+ *         the sums independent of the offset of the data, and statistics
+ *         that differ from the observed one by less than that error
+ *         (eps*(4*|r| + max|a|/d), with eps = ntotal*epsilon and d the
+ *         denominator of the statistic) count as ties, so that
+ *         relabelings of the observed split are counted independently of
+ *         the order of the values. If 0, tmp is not used.
+ */
+inline REAL permv (const REAL *a, int *n, int ntotal, const int *prm,
+                   int np, Func1 *func, int ties, REAL *tmp, REAL *s)
+{
+  assert(a && n && prm && (np > 0) && (ntotal <= PERMV_MAXN));
+  assert(!ties || tmp);
+  assert((func == mdiff_w) || (func == tstat2_w) || (func == pairedt_w));
+
+  enum { L = PERMV_LANES };
+  REAL t[PERMV_MAXN*L];              // block of permutations (SoA)
+  REAL s1[L], s2[L], r[L], d[L];     // sums, statistics, denominators
+  int  n1 = n[0];
+  int  n2 = (func == pairedt_w) ? n[0] : n[1];
+  REAL sval = 0;                     // |observed statistic| (- tol.)
+  REAL eps  = (REAL)ntotal * ((sizeof(REAL) == sizeof(float))
+            ? (REAL)FLT_EPSILON : (REAL)DBL_EPSILON);
+  if (s)                             // store the statistic
+    *s = func(a, n);
+
+  const REAL *x = a;                 // data to gather from
+  REAL amax = 0;                     // max. |centered value|
+  if (ties) {                        // center the data
+    REAL m = mean(a, ntotal);
+    for (int j = 0; j < ntotal; j++) {
+      tmp[j] = a[j] - m;
+      if (fabs(tmp[j]) > amax) amax = (REAL)fabs(tmp[j]);
+    }
+    if (func == pairedt_w)           // (bound on the differences)
+      amax *= 2;
+    x = tmp;
+  }
+
+  int cnt = 0;                       // (block -L: observed statistic)
+  for (int i = -L; i < np; i += L) {
+    if (i < 0) {                     // observed data (no permutation)
+      for (int l = 0; l < L; l++)
+        for (int j = 0; j < ntotal; j++)
+          t[j*L+l] = x[j];
+    }
+    else {                           // gather the block (the last one is
+      for (int l = 0; l < L; l++) {  // padded with copies)
+        int k = (i+l < np) ? i+l : np-1;
+        const int *pi = prm + (size_t)k*(size_t)ntotal;
+        for (int j = 0; j < ntotal; j++)
+          t[j*L+l] = x[pi[j]];
+      }
+    }
+    for (int l = 0; l < L; l++)
+      s1[l] = s2[l] = 0;
+
+    if (func == pairedt_w) {         // paired t statistic
+      for (int j = 0; j < n1; j++)   // (differences in the first half)
+        for (int l = 0; l < L; l++) {
+          t[j*L+l] -= t[(n1+j)*L+l];
+          s1[l]    += t[j*L+l];
+        }
+      for (int l = 0; l < L; l++)
+        s1[l] /= (REAL)n1;
+      for (int j = 0; j < n1; j++)
+        for (int l = 0; l < L; l++)
+          s2[l] += (t[j*L+l] - s1[l]) * (t[j*L+l] - s1[l]);
+      for (int l = 0; l < L; l++) {
+        d[l] = sqrt(s2[l]/(REAL)(n1-1)) / sqrt((REAL)n1);
+        r[l] = s1[l] / d[l];
+      }
+    }
+    else {                           // group means
+      for (int j = 0; j < n1; j++)
+        for (int l = 0; l < L; l++)
+          s1[l] += t[j*L+l];
+      for (int j = n1; j < n1+n2; j++)
+        for (int l = 0; l < L; l++)
+          s2[l] += t[j*L+l];
+      for (int l = 0; l < L; l++) {
+        s1[l] /= (REAL)n1;
+        s2[l] /= (REAL)n2;
+        r[l]   = s1[l] - s2[l];
+        d[l]   = 1;
+      }
+      if (func == tstat2_w) {        // pooled t statistic
+        REAL q[L];
+        for (int l = 0; l < L; l++)
+          q[l] = 0;
+        for (int j = 0; j < n1; j++)
+          for (int l = 0; l < L; l++)
+            q[l] += (t[j*L+l] - s1[l]) * (t[j*L+l] - s1[l]);
+        for (int j = n1; j < n1+n2; j++)
+          for (int l = 0; l < L; l++)
+            q[l] += (t[j*L+l] - s2[l]) * (t[j*L+l] - s2[l]);
+        REAL df = (REAL)n1 + (REAL)n2 - 2;
+        REAL f  = sqrt(1/(REAL)n1 + 1/(REAL)n2);
+        for (int l = 0; l < L; l++) {
+          d[l]  = sqrt(q[l]/df) * f;
+          r[l] /= d[l];
+        }
+      }
+    }
+
+    if (i < 0) {                     // observed statistic
+      sval = (REAL)fabs(r[0]);
+      if (ties)
+        sval -= eps*(4*sval + amax/d[0]);
+      continue;
+    }
+    for (int l = 0; (l < L) && (i+l < np); l++)
+      cnt += (fabs(r[l]) >= sval);
+  }
+
+  return (REAL)(cnt + 1)/(REAL)(np + 1);
+}  // permv()
+
+/*--------------------------------------------------------------------------*/
+
+/* rankperm
+ * --------
+ * permutation test for the Wilcoxon rank sum / Mann-Whitney U test
+ *
+ * The ranks are invariant under relabeling. They are computed only once,
+ * and each permutation reduces to summing up the ranks of sample #1.
+ * The parameters are the same as for perm() with func = ranksum_w,
+ * except that tmp has to hold 2*ntotal REAL values.
+ *
+ * returns
+ * p value (the z score of U is stored in s, if s is not NULL)
+ */
+inline REAL rankperm (const REAL *a, int *n, int ntotal, const int *prm,
+                      int np, REAL *tmp, REAL *s)
+{
+  assert(a && n && (n[0] > 0) && (n[1] > 0) && prm && (np > 0) && tmp);
+
+  int  n1 = n[0], n2 = n[1];
+  REAL *r = tmp;                            // ranks of the data
+  REAL *e = tmp + ntotal;                   // (buffer for concatenation)
+  for (int i = 0; i < n1+n2; i++)
+    e[i] = a[i];
+  double tt = (double)ranks(e, n1+n2, r);
+
+  double N  = (double)(n1+n2);
+  double mu = (double)n1*(N+1)/2;           // expected rank sum
+  double r1 = 0;
+  for (int j = 0; j < n1; j++)
+    r1 += (double)r[j];
+  double dev = fabs(r1 - mu);
+
+  if (s) {                                  // store the z score
+    REAL sd = sqrt((REAL)((double)n1*(double)n2/12 *((N+1) - tt/(N*(N-1)))));
+    *s = (sd > 0) ? (REAL)(r1 - mu)/sd : 0;
+  }
+
+  int cnt = 0;                              // initialize counter
+  for (int i = 0; i < np; i++) {            // for each permutation
+    const int *pi = prm + (size_t)i*(size_t)ntotal;
+    double rs = 0;                          // gather the ranks of the
+    for (int j = 0; j < n1; j++)            // permuted sample #1
+      rs += (double)r[pi[j]];
+    if (fabs(rs - mu) >= dev)               // count how many rank sums
+      cnt++;                                // were as or more extreme
+  }
+
+  return (REAL)(cnt + 1)/(REAL)(np + 1);    // return the p value
+}  // rankperm()
+
+/*--------------------------------------------------------------------------*/
+
+/* signperm
+ * --------
+ * permutation test for the Wilcoxon signed rank test
+ *
+ * The ranks of the absolute differences are invariant under exchanging
+ * the members of a pair. They are computed only once, and each
+ * permutation reduces to summing up the ranks of the differences that
+ * are positive after the exchanges. The parameters are the same as for
+ * perm() with func = signrank_w (a = [x1 x2], n[0] = number of pairs),
+ * except that tmp has to hold 3*n[0] REAL values. The permutations must
+ * only exchange the members of pairs, i.e., prm[i*ntotal+j] has to be
+ * either j or n[0]+j for j < n[0] (prm[i*ntotal+n[0]+j] is ignored).
+ *
+ * returns
+ * p value (the z score of W+ is stored in s, if s is not NULL)
+ */
+inline REAL signperm (const REAL *a, int *n, int ntotal, const int *prm,
+                      int np, REAL *tmp, REAL *s)
+{
+  assert(a && n && (n[0] > 0) && prm && (np > 0) && tmp);
+
+  int  m  = n[0];
+  REAL *d = tmp;                            // absolute differences
+  REAL *r = tmp + m;                        // signed ranks
+  REAL *q = r + m;                          // ranks
+  for (int i = 0; i < m; i++) {
+    REAL di = a[i] - a[m+i];
+    d[i] = (di < 0) ? -di : di;
+  }
+  double tt = (double)ranks(d, m, q);
+  int    nz = 0;                            // number of zero differences
+  for (int i = 0; i < m; i++)
+    nz += (d[i] == 0);
+  for (int i = 0; i < m; i++) {             // combine ranks and signs;
+    REAL di = a[i] - a[m+i];                // zero differences have the
+    REAL ri = q[i] - (REAL)nz;              // lowest ranks and are
+    r[i] = (di > 0) ? ri : (di < 0) ? -ri : 0;  // discarded (signrank())
+  }
+  tt -= (double)nz*(double)nz*(double)nz - (double)nz;
+
+  double M  = (double)(m - nz);
+  double mu = M*(M+1)/4;                    // expected sum of the ranks
+  double w  = 0;                            // of the positive differences
+  for (int j = 0; j < m; j++)
+    if (r[j] > 0) w += (double)r[j];
+  double dev = fabs(w - mu);
+
+  if (s) {                                  // store the z score
+    REAL sw = sqrt((REAL)(M*(M+1)*(2*M+1)/24 - tt/48));
+    *s = (sw > 0) ? (REAL)(w - mu)/sw : 0;
+  }
+
+  int cnt = 0;                              // initialize counter
+  for (int i = 0; i < np; i++) {            // for each permutation
+    const int *pi = prm + (size_t)i*(size_t)ntotal;
+    double ws = 0;                          // gather the signed ranks,
+    for (int j = 0; j < m; j++) {           // flipping the sign of
+      REAL rj = (pi[j] < m) ? r[j] : -r[j]; // exchanged pairs
+      ws += (rj > 0) ? (double)rj : 0;
+    }
+    if (fabs(ws - mu) >= dev)               // count how many rank sums
+      cnt++;                                // were as or more extreme
+  }
+
+  return (REAL)(cnt + 1)/(REAL)(np + 1);    // return the p value
+}  // signperm()
+
+/*--------------------------------------------------------------------------*/
+
+/* anova1perm
+ * ----------
+ * permutation test for the one-way analysis of variance
+ *
+ * The total sum and the total sum of squares are invariant under
+ * relabeling, so the F statistic is a monotone function of the between
+ * sum of squares. The data are centered once; each permutation then
+ * only requires the sums of the first k-1 permuted samples (the sum of
+ * the last sample follows from the total sum being zero). The observed
+ * statistic is computed in the same way. Between sums of squares that
+ * differ from it by less than the rounding error of the sums
+ * (4*ntotal*epsilon, relative to the total sum of squares) count as
+ * ties. The parameters are the same as for perm() with func = anova1_w
+ * (n terminated by 0).
+ *
+ * returns
+ * p value (the F statistic is stored in s, if s is not NULL)
+ */
+inline REAL anova1perm (const REAL *a, int *n, int ntotal, const int *prm,
+                        int np, REAL *tmp, REAL *s)
+{
+  assert(a && n && prm && (np > 0) && tmp);
+
+  int k = 0;                                // get the number of samples
+  while (n[k] > 0) k++;
+  assert((k > 1) && (ntotal > k));
+
+  REAL m = mean(a, ntotal);                 // center the data
+  for (int j = 0; j < ntotal; j++)
+    tmp[j] = a[j] - m;
+  REAL st = dot(tmp, tmp, ntotal);          // total sum of squares
+  REAL tol = (REAL)(4*ntotal) * st * ((sizeof(REAL) == sizeof(float))
+           ? (REAL)FLT_EPSILON : (REAL)DBL_EPSILON);
+
+  REAL sb = 0;                              // (i = -1: observed data)
+  int cnt = 0;                              // initialize counter
+  for (int i = -1; i < np; i++) {           // for each permutation
+    const int *pi = (i < 0) ? NULL : prm + (size_t)i*(size_t)ntotal;
+    REAL sp = 0, rest = 0;                  // between sum of squares and
+    for (int g = 0, o = 0; g < k-1; o += n[g++]) {  // sum of samples
+      REAL sg = 0;
+      for (int j = o; j < o+n[g]; j++)      // gather the permuted sample
+        sg += tmp[pi ? pi[j] : j];
+      sp   += sg*sg/(REAL)n[g];
+      rest += sg;
+    }
+    sp += rest*rest/(REAL)n[k-1];           // sum of the last sample
+    if (i < 0) {                            // observed statistic
+      sb = sp;
+      if (s) *s = (sb/(REAL)(k-1)) / ((st-sb)/(REAL)(ntotal-k));
+      continue;
+    }
+    if (sp >= sb - tol)                     // count how many statistics
+      cnt++;                                // were as or more extreme than
+  }                                         // the one originally observed
+
+  return (REAL)(cnt + 1)/(REAL)(np + 1);    // return the p value
+}  // anova1perm()
+
+/*--------------------------------------------------------------------------*/
+
 inline REAL fr2z (REAL r)
 {
   if (r <= (REAL)-1) return (REAL)-R2Z_MAX;
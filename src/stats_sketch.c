@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------
+  File    : stats_sketch.c
+  Contents: mergeable quantile sketch (KLL) for streams of data
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stats_sketch.h"
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static unsigned long long rnd (unsigned long long *state)
+{                               // --- next random number (splitmix64)
+  unsigned long long z = (*state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}  // rnd()
+
+/*--------------------------------------------------------------------------*/
+
+static int levcap (int k, int nlev, int h)
+{                               // --- capacity of level h
+  double c = (double)k;         // (k (2/3)^depth, at least SKETCH_MINCAP)
+  for (int d = nlev-1-h; (d > 0) && (c > SKETCH_MINCAP); d--)
+    c *= 2/3.0;
+  int cap = (int)ceil(c);
+  return (cap > SKETCH_MINCAP) ? cap : SKETCH_MINCAP;
+}  // levcap()
+
+/*--------------------------------------------------------------------------*/
+
+static int totcap (int k, int nlev)
+{                               // --- total capacity of all levels
+  int cap = 0;
+  for (int h = 0; h < nlev; h++)
+    cap += levcap(k, nlev, h);
+  return cap;
+}  // totcap()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL              float // (re)define REAL to be float
+#define sketch            ssketch
+#define sketch_create     ssketch_create
+#define sketch_delete     ssketch_delete
+#define sketch_add        ssketch_add
+#define sketch_merge      ssketch_merge
+#define sketch_quantiles  ssketch_quantiles
+#define sketch_rank       ssketch_rank
+#define skitem            sskitem
+#define sortv             ssortv
+#define itemcmp           sitemcmp
+#define reserve           sreserve
+#define mergeinto         smergeinto
+#define compress          scompress
+#include "stats_sketch_real.c"  // single precision versions
+#undef REAL
+#undef sketch
+#undef sketch_create
+#undef sketch_delete
+#undef sketch_add
+#undef sketch_merge
+#undef sketch_quantiles
+#undef sketch_rank
+#undef skitem
+#undef sortv
+#undef itemcmp
+#undef reserve
+#undef mergeinto
+#undef compress
+/*--------------------------------------------------------------------------*/
+#define REAL              double  // (re)define REAL to be double
+#define sketch            dsketch
+#define sketch_create     dsketch_create
+#define sketch_delete     dsketch_delete
+#define sketch_add        dsketch_add
+#define sketch_merge      dsketch_merge
+#define sketch_quantiles  dsketch_quantiles
+#define sketch_rank       dsketch_rank
+#define skitem            dskitem
+#define sortv             dsortv
+#define itemcmp           ditemcmp
+#define reserve           dreserve
+#define mergeinto         dmergeinto
+#define compress          dcompress
+#include "stats_sketch_real.c"  // double precision versions
+#undef REAL
+#undef sketch
+#undef sketch_create
+#undef sketch_delete
+#undef sketch_add
+#undef sketch_merge
+#undef sketch_quantiles
+#undef sketch_rank
+#undef skitem
+#undef sortv
+#undef itemcmp
+#undef reserve
+#undef mergeinto
+#undef compress
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
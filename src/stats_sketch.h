@@ -0,0 +1,172 @@
+/*----------------------------------------------------------------------------
+  File    : stats_sketch.h
+  Contents: mergeable quantile sketch (KLL) for streams of data
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_SKETCH_H
+#define STATS_SKETCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define SKETCH_K       200      // default accuracy parameter
+#define SKETCH_MINCAP  8        // minimum capacity of a level
+#define SKETCH_MAXLEV  48       // maximum number of levels
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct ssketch {        // --- quantile sketch (single precision)
+  int       k;                  // accuracy parameter
+  int       nlev;               // number of levels
+  int       cnt[SKETCH_MAXLEV]; // number of items per level
+  int       sz [SKETCH_MAXLEV]; // allocated sizes of the levels
+  float     *lev[SKETCH_MAXLEV];// items per level (weight 2^h; sorted
+                                // for h > 0)
+  long long n;                  // number of values added
+  float     lo, hi;             // smallest and largest value
+  unsigned long long rng;       // state of the random number generator
+} ssketch;
+
+typedef struct dsketch {        // --- quantile sketch (double precision)
+  int       k;                  // accuracy parameter
+  int       nlev;               // number of levels
+  int       cnt[SKETCH_MAXLEV]; // number of items per level
+  int       sz [SKETCH_MAXLEV]; // allocated sizes of the levels
+  double    *lev[SKETCH_MAXLEV];// items per level (weight 2^h; sorted
+                                // for h > 0)
+  long long n;                  // number of values added
+  double    lo, hi;             // smallest and largest value
+  unsigned long long rng;       // state of the random number generator
+} dsketch;
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+// The sketch is a KLL sketch (Karnin, Lang & Liberty, 2016) with the
+// level capacities of the Apache DataSketches implementation: the top
+// level holds k items, each lower level 2/3 as many (at least
+// SKETCH_MINCAP). An item on level h represents 2^h values. When the
+// sketch is full, the lowest level that exceeds its capacity is sorted,
+// and every other item (random offset) is promoted to the next level.
+// The memory used is O(k log(n/k)) values, independent of n for all
+// practical purposes (about 3k + SKETCH_MINCAP log2(n/k) items).
+//
+// Rank error: with probability 0.99, the normalized rank error of a
+// single quantile or rank query is at most about 2.3/k^0.97 (1.3% for
+// k = 200, 0.3% for k = 1000); it does not depend on n or on the order
+// in which the values are added or the sketches are merged.
+
+/* sketch_create
+ * -------------
+ * create an empty quantile sketch
+ *
+ * k      accuracy parameter (>= SKETCH_MINCAP, e.g., SKETCH_K)
+ * seed   seed of the random number generator (compaction offsets)
+ *
+ * returns
+ * the sketch or NULL if memory allocation failed
+ */
+extern ssketch* ssketch_create    (int k, unsigned long long seed);
+extern dsketch* dsketch_create    (int k, unsigned long long seed);
+
+/* sketch_delete
+ * -------------
+ * delete a quantile sketch
+ */
+extern void     ssketch_delete    (ssketch *s);
+extern void     dsketch_delete    (dsketch *s);
+
+/* sketch_add
+ * ----------
+ * add an array of values to a sketch
+ *
+ * The values are appended to level 0 in chunks that fill the free
+ * capacity of the sketch. Each chunk is scanned once for its minimum,
+ * maximum and NaNs (a branch-free loop that is vectorized by the
+ * compiler) and then copied as a whole; NaNs are skipped.
+ *
+ * a      values (n values)
+ * n      number of values
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed
+ */
+extern int      ssketch_add       (ssketch *s, const float  *a, int n);
+extern int      dsketch_add       (dsketch *s, const double *a, int n);
+
+/* sketch_merge
+ * ------------
+ * merge a sketch into another one (e.g., per-thread or per-file
+ * sketches); src is not changed
+ *
+ * The sketches have to have the same k. The rank error bound of the
+ * merged sketch is the same as that of a single sketch of all values.
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed
+ */
+extern int      ssketch_merge     (ssketch *dst, const ssketch *src);
+extern int      dsketch_merge     (dsketch *dst, const dsketch *src);
+
+/* sketch_quantiles
+ * ----------------
+ * estimate quantiles from a sketch
+ *
+ * The estimate of the q-quantile is the smallest item whose cumulative
+ * weight is at least q*n; q <= 0 and q >= 1 yield the smallest and the
+ * largest value that was added (NaN for an empty sketch).
+ *
+ * q      probabilities (m values in [0,1])
+ * m      number of probabilities
+ * r      buffer for the m quantiles
+ *
+ * returns
+ * 0 on success, -1 if memory allocation failed
+ */
+extern int      ssketch_quantiles (const ssketch *s, const float  *q, int m,
+                                   float  *r);
+extern int      dsketch_quantiles (const dsketch *s, const double *q, int m,
+                                   double *r);
+
+/* sketch_rank
+ * -----------
+ * estimate the fraction of the values that are <= x (NaN for an empty
+ * sketch)
+ */
+extern double   ssketch_rank      (const ssketch *s, float  x);
+extern double   dsketch_rank      (const dsketch *s, double x);
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions: generic names
+----------------------------------------------------------------------------*/
+#ifdef REAL
+#  if REAL_IS_DOUBLE
+#    define sketch            dsketch
+#    define sketch_create     dsketch_create
+#    define sketch_delete     dsketch_delete
+#    define sketch_add        dsketch_add
+#    define sketch_merge      dsketch_merge
+#    define sketch_quantiles  dsketch_quantiles
+#    define sketch_rank       dsketch_rank
+#  else
+#    define sketch            ssketch
+#    define sketch_create     ssketch_create
+#    define sketch_delete     ssketch_delete
+#    define sketch_add        ssketch_add
+#    define sketch_merge      ssketch_merge
+#    define sketch_quantiles  ssketch_quantiles
+#    define sketch_rank       ssketch_rank
+#  endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_SKETCH_H
@@ -0,0 +1,264 @@
+/*----------------------------------------------------------------------------
+  File    : stats_sketch_real.c
+  Contents: this file is to be included from stats_sketch.c
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- weighted item (for queries)
+  REAL       v;                 // value
+  long long  w;                 // weight (then cumulative weight)
+} skitem;
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void sortv (REAL *a, int n)
+{                               // --- sort values (quicksort with a
+  while (n > 16) {              // median-of-three pivot, recursion only
+    REAL x = a[0], y = a[n/2], z = a[n-1];  // on the smaller part,
+    REAL p = (x < y) ? ((y < z) ? y : (x < z) ? z : x)
+                     : ((x < z) ? x : (y < z) ? z : y);
+    int i = 0, j = n-1;         // insertion sort for small parts)
+    while (i <= j) {
+      while (a[i] < p) i++;
+      while (a[j] > p) j--;
+      if (i <= j) { REAL t = a[i]; a[i++] = a[j]; a[j--] = t; }
+    }
+    if (j+1 < n-i) { sortv(a, j+1); a += i; n -= i; }
+    else           { sortv(a+i, n-i); n = j+1; }
+  }
+  for (int i = 1; i < n; i++) { // insertion sort
+    REAL t = a[i]; int j = i;
+    for ( ; (j > 0) && (a[j-1] > t); j--) a[j] = a[j-1];
+    a[j] = t;
+  }
+}  // sortv()
+
+/*--------------------------------------------------------------------------*/
+
+static int itemcmp (const void *p1, const void *p2)
+{                               // --- compare two weighted items
+  REAL x = ((const skitem*)p1)->v, y = ((const skitem*)p2)->v;
+  return (x < y) ? -1 : (x > y) ? 1 : 0;
+}  // itemcmp()
+
+/*--------------------------------------------------------------------------*/
+
+static int reserve (sketch *s, int h, int n)
+{                               // --- make room for n items on level h
+  if (n <= s->sz[h]) return 0;
+  int sz = 2*s->sz[h];
+  if (sz < n) sz = n;
+  REAL *p = (REAL*) realloc(s->lev[h], (size_t)sz *sizeof(REAL));
+  if (!p) return -1;
+  s->lev[h] = p; s->sz[h] = sz;
+  return 0;
+}  // reserve()
+
+/*--------------------------------------------------------------------------*/
+
+static void mergeinto (REAL *a, int na, const REAL *b, int nb)
+{                               // --- merge sorted b into sorted a
+  int i = na-1, j = nb-1;       // (a has room for na+nb values;
+  for (int o = na+nb-1; j >= 0; o--)    // merged from the back)
+    a[o] = ((i >= 0) && (a[i] > b[j])) ? a[i--] : b[j--];
+}  // mergeinto()
+
+/*--------------------------------------------------------------------------*/
+
+static int compress (sketch *s)
+{                               // --- compact until the sketch has room
+  for (;;) {
+    int tot = 0;
+    for (int h = 0; h < s->nlev; h++)
+      tot += s->cnt[h];
+    if (tot < totcap(s->k, s->nlev))
+      return 0;
+
+    // find the lowest level that exceeds its capacity
+    int h = 0;
+    while ((h < s->nlev-1) && (s->cnt[h] < levcap(s->k, s->nlev, h)))
+      h++;
+    if (h == s->nlev-1) {       // if it is the top level,
+      assert(s->nlev < SKETCH_MAXLEV);  // add a level on top
+      s->nlev++;
+    }
+
+    // promote every other item (random offset) to the next level
+    REAL *a = s->lev[h];
+    int m = s->cnt[h];
+    if (h == 0)                 // (only level 0 is unsorted)
+      sortv(a, m);
+    int keep = m & 1;           // (odd number: keep the smallest item)
+    int o    = keep + (int)(rnd(&s->rng) & 1);
+    int half = (m-keep)/2;
+    for (int j = 0; j < half; j++)
+      a[keep+j] = a[o+2*j];
+    if (reserve(s, h+1, s->cnt[h+1] + half) != 0)
+      return -1;
+    mergeinto(s->lev[h+1], s->cnt[h+1], a+keep, half);
+    s->cnt[h+1] += half;
+    s->cnt[h]    = keep;
+  }
+}  // compress()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+sketch* sketch_create (int k, unsigned long long seed)
+{
+  assert(k >= SKETCH_MINCAP);
+
+  sketch *s = (sketch*) calloc(1, sizeof(sketch));
+  if (!s) return NULL;
+  s->k    = k;
+  s->nlev = 1;
+  s->n    = 0;
+  s->lo   = (REAL) INFINITY;
+  s->hi   = (REAL)-INFINITY;
+  s->rng  = seed;
+  if (reserve(s, 0, k) != 0) {
+    sketch_delete(s); return NULL; }
+  return s;
+}  // sketch_create()
+
+/*--------------------------------------------------------------------------*/
+
+void sketch_delete (sketch *s)
+{
+  if (!s) return;
+  for (int h = 0; h < SKETCH_MAXLEV; h++)
+    free(s->lev[h]);
+  free(s);
+}  // sketch_delete()
+
+/*--------------------------------------------------------------------------*/
+
+int sketch_add (sketch *s, const REAL *a, int n)
+{
+  assert(s && (a || (n <= 0)));
+
+  for (int i = 0; i < n; ) {
+    int tot = 0;                // fill the free capacity of the sketch
+    for (int h = 0; h < s->nlev; h++)
+      tot += s->cnt[h];
+    int m = totcap(s->k, s->nlev) - tot;
+    if (m > n-i) m = n-i;
+    if (reserve(s, 0, s->cnt[0] + m) != 0)
+      return -1;
+
+    const REAL *x = a + i;      // scan the chunk (vectorized)
+    REAL lo = s->lo, hi = s->hi;
+    int  nan = 0;
+    for (int j = 0; j < m; j++) {
+      lo   = (x[j] < lo) ? x[j] : lo;
+      hi   = (x[j] > hi) ? x[j] : hi;
+      nan += (x[j] != x[j]);
+    }
+    REAL *b = s->lev[0] + s->cnt[0];
+    int  c  = m;                // append the chunk to level 0
+    if (!nan)                   // (skipping NaNs, if any)
+      memcpy(b, x, (size_t)m *sizeof(REAL));
+    else {
+      c = 0;
+      for (int j = 0; j < m; j++) {
+        b[c] = x[j]; c += (x[j] == x[j]); }
+    }
+    s->lo = lo; s->hi = hi;
+    s->cnt[0] += c;
+    s->n      += c;
+    i         += m;
+    if (compress(s) != 0)
+      return -1;
+  }
+  return 0;
+}  // sketch_add()
+
+/*--------------------------------------------------------------------------*/
+
+int sketch_merge (sketch *dst, const sketch *src)
+{
+  assert(dst && src && (dst != src) && (dst->k == src->k));
+
+  if (dst->nlev < src->nlev)    // (the levels above are empty)
+    dst->nlev = src->nlev;
+  for (int h = 0; h < src->nlev; h++) {
+    int m = src->cnt[h];
+    if (m == 0) continue;
+    if (reserve(dst, h, dst->cnt[h] + m) != 0)
+      return -1;
+    if (h == 0)                 // append level 0, merge the sorted levels
+      memcpy(dst->lev[0] + dst->cnt[0], src->lev[0],
+             (size_t)m *sizeof(REAL));
+    else
+      mergeinto(dst->lev[h], dst->cnt[h], src->lev[h], m);
+    dst->cnt[h] += m;
+  }
+  dst->n += src->n;
+  if (src->lo < dst->lo) dst->lo = src->lo;
+  if (src->hi > dst->hi) dst->hi = src->hi;
+  return compress(dst);
+}  // sketch_merge()
+
+/*--------------------------------------------------------------------------*/
+
+int sketch_quantiles (const sketch *s, const REAL *q, int m, REAL *r)
+{
+  assert(s && (q || (m <= 0)) && (r || (m <= 0)));
+
+  if (s->n <= 0) {
+    for (int i = 0; i < m; i++)
+      r[i] = (REAL)NAN;
+    return 0;
+  }
+  int tot = 0;                  // collect and sort the weighted items
+  for (int h = 0; h < s->nlev; h++)
+    tot += s->cnt[h];
+  skitem *it = (skitem*) malloc((size_t)tot *sizeof(skitem));
+  if (!it) return -1;
+  for (int h = 0, c = 0; h < s->nlev; h++)
+    for (int j = 0; j < s->cnt[h]; j++, c++) {
+      it[c].v = s->lev[h][j];
+      it[c].w = 1LL << h;
+    }
+  qsort(it, (size_t)tot, sizeof(skitem), itemcmp);
+  for (int c = 1; c < tot; c++) // cumulative weights
+    it[c].w += it[c-1].w;
+
+  for (int i = 0; i < m; i++) {
+    if      (!(q[i] > 0)) { r[i] = s->lo; continue; }
+    else if (!(q[i] < 1)) { r[i] = s->hi; continue; }
+    double t = (double)q[i] * (double)s->n;
+    int lo = 0, hi = tot-1;     // find the smallest item with
+    while (lo < hi) {           // cumulative weight >= q*n
+      int mid = lo + (hi-lo)/2;
+      if ((double)it[mid].w >= t) hi = mid;
+      else                        lo = mid+1;
+    }
+    r[i] = it[lo].v;
+  }
+  free(it);
+  return 0;
+}  // sketch_quantiles()
+
+/*--------------------------------------------------------------------------*/
+
+double sketch_rank (const sketch *s, REAL x)
+{
+  assert(s);
+
+  if (s->n <= 0) return NAN;
+  long long w = 0;
+  for (int h = 0; h < s->nlev; h++) {
+    int c = 0;
+    for (int j = 0; j < s->cnt[h]; j++)
+      c += (s->lev[h][j] <= x);
+    w += (long long)c << h;
+  }
+  return (double)w / (double)s->n;
+}  // sketch_rank()
@@ -10,3 +10,7 @@
 ----------------------------------------------------------------------------*/
 extern float  ssum_sse2     (const float  *a, int n);
 extern float  svarm_sse2    (const float  *a, int n, float m);
+extern void   spivcnt_sse2  (const float  *a, int n, float  p,
+                             int *lt, int *eq);
+extern void   dpivcnt_sse2  (const double *a, int n, double p,
+                             int *lt, int *eq);
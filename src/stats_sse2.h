@@ -30,11 +30,31 @@
 #  endif
 #endif
 
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#ifndef SSE2_NACC
+#define SSE2_NACC 8             // number of independent accumulators
+#endif
+// The main loops use SSE2_NACC accumulators to hide the latency of the
+// additions (4 cycles on most cores, with 2 additions per cycle). Each
+// element is loaded once. Unaligned heads and tails of at most 3 values
+// are handled with a masked vector instead of scalar loops.
+
+#define SSE2_HEAD(k) _mm_castsi128_ps(_mm_cmplt_epi32( \
+  _mm_set_epi32(3,2,1,0), _mm_set1_epi32(k)))   // mask: first k lanes
+#define SSE2_TAIL(k) _mm_castsi128_ps(_mm_cmpgt_epi32( \
+  _mm_set_epi32(3,2,1,0), _mm_set1_epi32(3-(k))))  // mask: last k lanes
+
 /*----------------------------------------------------------------------------
   Function Prototypes
 ----------------------------------------------------------------------------*/
 inline float  ssum_sse2    (const float  *a, int n);
 inline float  svarm_sse2   (const float  *a, int n, float m);
+inline void   spivcnt_sse2 (const float  *a, int n, float  p,
+                            int *lt, int *eq);
+inline void   dpivcnt_sse2 (const double *a, int n, double p,
+                            int *lt, int *eq);
 
 /*----------------------------------------------------------------------------
   Inline Functions
@@ -48,50 +68,67 @@ inline float ssum_sse2 (const float *a, int n)
 {
   assert(a && (n > 0));
 
-  // initialize total sum
-  float s = 0.0f;
-
-  // add up to 3 values without SIMD to achieve alignment
-  int aligned = is_aligned(a, 16);
-  if (!aligned) {
-    int k = 0;
-    while (!aligned) {
-      s += (*a);
-      n--; a++;
-      aligned = is_aligned(a, 16);
-      if (aligned || (++k > 2) || (n == 0))
-        break;
-    }
+  if (n < 4) {                  // too few values for a vector
+    float s = a[0];
+    for (int k = 1; k < n; k++)
+      s += a[k];
+    return s;
   }
 
-  // initialize 4 sums
-  __m128 s4 = _mm_setzero_ps();
+  __m128 s4[SSE2_NACC];         // initialize the accumulators
+  for (int j = 0; j < SSE2_NACC; j++)
+    s4[j] = _mm_setzero_ps();
 
-  // in each iteration, add 1 value to each of the 4 sums in parallel
-  if (is_aligned(a, 16))
-    for (int k = 0, nq = 4*(n/4); k < nq; k += 4)
-      s4 = _mm_add_ps(s4, _mm_load_ps(a+k));
-  else
-    for (int k = 0, nq = 4*(n/4); k < nq; k += 4)
-      s4 = _mm_add_ps(s4, _mm_loadu_ps(a+k));
+  // add the unaligned head (masked unaligned load of the first 4 values)
+  int h = (int)((16 - (uintptr_t)a % 16) % 16) / 4;
+  if (h > 0 && is_aligned(a, 4)) {
+    __m128 mk = SSE2_HEAD(h);
+    s4[0] = _mm_and_ps(_mm_loadu_ps(a), mk);
+    a += h; n -= h;
+  }
 
+  // add SSE2_NACC vectors (1 per accumulator) in each iteration
+  int k = 0;
+  if (is_aligned(a, 16)) {
+    for ( ; k+4*SSE2_NACC <= n; k += 4*SSE2_NACC)
+      for (int j = 0; j < SSE2_NACC; j++)
+        s4[j] = _mm_add_ps(s4[j], _mm_load_ps(a+k+4*j));
+    for ( ; k+4 <= n; k += 4)
+      s4[k/4 % SSE2_NACC] = _mm_add_ps(s4[k/4 % SSE2_NACC],
+                                       _mm_load_ps(a+k));
+  }
+  else {                        // (data not aligned to 4 bytes)
+    for ( ; k+4*SSE2_NACC <= n; k += 4*SSE2_NACC)
+      for (int j = 0; j < SSE2_NACC; j++)
+        s4[j] = _mm_add_ps(s4[j], _mm_loadu_ps(a+k+4*j));
+    for ( ; k+4 <= n; k += 4)
+      s4[k/4 % SSE2_NACC] = _mm_add_ps(s4[k/4 % SSE2_NACC],
+                                       _mm_loadu_ps(a+k));
+  }
+
+  // add the tail (masked unaligned load of the last 4 values)
+  if (k < n) {
+    __m128 mk = SSE2_TAIL(n-k);
+    s4[1] = _mm_add_ps(s4[1], _mm_and_ps(_mm_loadu_ps(a+n-4), mk));
+  }
+
+  // combine the accumulators (pairwise)
+  for (int w = 1; w < SSE2_NACC; w *= 2)
+    for (int j = 0; j+w < SSE2_NACC; j += 2*w)
+      s4[j] = _mm_add_ps(s4[j], s4[j+w]);
   // compute horizontal sum
   #ifdef HORZSUM_SSE3
-  s4 = _mm_hadd_ps(s4,s4);
-  s4 = _mm_hadd_ps(s4,s4);
+  s4[0] = _mm_hadd_ps(s4[0],s4[0]);
+  s4[0] = _mm_hadd_ps(s4[0],s4[0]);
   #else
-  s4 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
-  s4 = _mm_add_ss(s4, _mm_shuffle_ps(s4, s4, 1));
+  s4[0] = _mm_add_ps(s4[0], _mm_movehl_ps(s4[0], s4[0]));
+  s4[0] = _mm_add_ss(s4[0], _mm_shuffle_ps(s4[0], s4[0], 1));
   #endif
-  s += _mm_cvtss_f32(s4);  // extract horizontal sum from 1st elem.
-
-  // add the remaining values
-  for (int k = 4*(n/4); k < n; k++)
-    s += a[k];
-
-  return s;
+  return _mm_cvtss_f32(s4[0]);  // extract horizontal sum from 1st elem.
 }  // ssum_sse2()
 
+/*--------------------------------------------------------------------------*/
+
 /* svarm_sse2
  * ----------
  * compute the unbiased sample variance if the mean is m
@@ -100,55 +137,180 @@ inline float svarm_sse2 (const float *a, int n, float m)
 {
   assert(a && (n > 1));
 
+  if (n < 4) {                  // too few values for a vector
+    float v = 0.0f;
+    for (int k = 0; k < n; k++)
+      v += (a[k] - m) * (a[k] - m);
+    return v / (float)(n-1);
+  }
+
   // save the original value of n for later use in the final division
   int orign = n;
 
-  // initialize result variable
-  float v = 0.0f;
-
-  // add up to 3 values without SIMD to achieve alignment
-  int aligned = is_aligned(a, 16);
-  if (!aligned) {
-    int k = 0;
-    while (!aligned) {
-      v += ((*a) - m) * ((*a) - m);
-      n--; a++;
-      aligned = is_aligned(a, 16);
-      if (aligned || (++k > 2) || (n == 0))
-        break;
-    }
-  }
+  __m128 s4[SSE2_NACC];         // initialize the accumulators
+  for (int j = 0; j < SSE2_NACC; j++)
+    s4[j] = _mm_setzero_ps();
+  __m128 m4 = _mm_set_ps1(m);
+  __m128 d;
 
-  // initialize 4 sums
-  __m128 s4 = _mm_setzero_ps();
+  // add the unaligned head (masked unaligned load of the first 4 values)
+  int h = (int)((16 - (uintptr_t)a % 16) % 16) / 4;
+  if (h > 0 && is_aligned(a, 4)) {
+    __m128 mk = SSE2_HEAD(h);
+    d = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(a), m4), mk);
+    s4[0] = _mm_mul_ps(d, d);
+    a += h; n -= h;
+  }
 
-  __m128 m4 = _mm_set_ps1(m);
+  // add SSE2_NACC vectors (1 per accumulator) in each iteration
+  // (each vector is loaded once and the deviation is squared in registers)
+  int k = 0;
+  if (is_aligned(a, 16)) {
+    for ( ; k+4*SSE2_NACC <= n; k += 4*SSE2_NACC)
+      for (int j = 0; j < SSE2_NACC; j++) {
+        d = _mm_sub_ps(_mm_load_ps(a+k+4*j), m4);
+        s4[j] = _mm_add_ps(s4[j], _mm_mul_ps(d, d));
+      }
+    for ( ; k+4 <= n; k += 4) {
+      d = _mm_sub_ps(_mm_load_ps(a+k), m4);
+      s4[k/4 % SSE2_NACC] = _mm_add_ps(s4[k/4 % SSE2_NACC],
+                                       _mm_mul_ps(d, d));
+    }
+  }
+  else {                        // (data not aligned to 4 bytes)
+    for ( ; k+4*SSE2_NACC <= n; k += 4*SSE2_NACC)
+      for (int j = 0; j < SSE2_NACC; j++) {
+        d = _mm_sub_ps(_mm_loadu_ps(a+k+4*j), m4);
+        s4[j] = _mm_add_ps(s4[j], _mm_mul_ps(d, d));
+      }
+    for ( ; k+4 <= n; k += 4) {
+      d = _mm_sub_ps(_mm_loadu_ps(a+k), m4);
+      s4[k/4 % SSE2_NACC] = _mm_add_ps(s4[k/4 % SSE2_NACC],
+                                       _mm_mul_ps(d, d));
+    }
+  }
 
-  // in each iteration, add 1 value to each of the 4 sums in parallel
-  if (is_aligned(a, 16))
-    for (int k = 0, nq = 4*(n/4); k < nq; k += 4)
-      s4 = _mm_add_ps(s4, _mm_mul_ps(_mm_sub_ps(_mm_load_ps(a+k), m4),
-                                     _mm_sub_ps(_mm_load_ps(a+k), m4)));
-  else
-    for (int k = 0, nq = 4*(n/4); k < nq; k += 4)
-      s4 = _mm_add_ps(s4, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(a+k), m4),
-                                     _mm_sub_ps(_mm_loadu_ps(a+k), m4)));
+  // add the tail (masked unaligned load of the last 4 values)
+  if (k < n) {
+    __m128 mk = SSE2_TAIL(n-k);
+    d = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(a+n-4), m4), mk);
+    s4[1] = _mm_add_ps(s4[1], _mm_mul_ps(d, d));
+  }
 
+  // combine the accumulators (pairwise)
+  for (int w = 1; w < SSE2_NACC; w *= 2)
+    for (int j = 0; j+w < SSE2_NACC; j += 2*w)
+      s4[j] = _mm_add_ps(s4[j], s4[j+w]);
   // compute horizontal sum
   #ifdef HORZSUM_SSE3
-  s4 = _mm_hadd_ps(s4,s4);
-  s4 = _mm_hadd_ps(s4,s4);
+  s4[0] = _mm_hadd_ps(s4[0],s4[0]);
+  s4[0] = _mm_hadd_ps(s4[0],s4[0]);
   #else
-  s4 = _mm_add_ps(s4, _mm_movehl_ps(s4, s4));
-  s4 = _mm_add_ss(s4, _mm_shuffle_ps(s4, s4, 1));
+  s4[0] = _mm_add_ps(s4[0], _mm_movehl_ps(s4[0], s4[0]));
+  s4[0] = _mm_add_ss(s4[0], _mm_shuffle_ps(s4[0], s4[0], 1));
   #endif
-  v += _mm_cvtss_f32(s4);  // extract horizontal sum from 1st elem.
+  return _mm_cvtss_f32(s4[0]) / (float)(orign-1);
+}  // svarm_sse2()
 
-  // add the remaining values
-  for (int k = 4*(n/4); k < n; k++)
-    v += (a[k] - m) * (a[k] - m);
+/*--------------------------------------------------------------------------*/
 
-  return v /= (float)(orign-1);
-}  // svarm_sse2()
+/* spivcnt_sse2
+ * ------------
+ * count the values less than and equal to the pivot p
+ * (single precision; SSE2 implementation)
+ *
+ * The comparison masks are -1 in the lanes where the comparisons hold;
+ * they are subtracted from integer accumulators (two per count).
+ */
+inline void spivcnt_sse2 (const float *a, int n, float p, int *lt, int *eq)
+{
+  assert(a && (n > 0) && lt && eq);
+
+  int l = 0, e = 0;
+  if (n < 4) {                  // too few values for a vector
+    for (int k = 0; k < n; k++) {
+      l += (a[k] < p); e += (a[k] == p); }
+    *lt = l; *eq = e; return;
+  }
+
+  __m128  p4 = _mm_set_ps1(p);
+  __m128i l4[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+  __m128i e4[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+  __m128  x;
+
+  // compare 2 vectors to the pivot in each iteration
+  int k = 0;
+  for ( ; k+8 <= n; k += 8)
+    for (int j = 0; j < 2; j++) {
+      x = _mm_loadu_ps(a+k+4*j);
+      l4[j] = _mm_sub_epi32(l4[j], _mm_castps_si128(_mm_cmplt_ps(x, p4)));
+      e4[j] = _mm_sub_epi32(e4[j], _mm_castps_si128(_mm_cmpeq_ps(x, p4)));
+    }
+  if (k+4 <= n) {
+    x = _mm_loadu_ps(a+k);
+    l4[0] = _mm_sub_epi32(l4[0], _mm_castps_si128(_mm_cmplt_ps(x, p4)));
+    e4[0] = _mm_sub_epi32(e4[0], _mm_castps_si128(_mm_cmpeq_ps(x, p4)));
+    k += 4;
+  }
+
+  // compare the tail (masked unaligned load of the last 4 values)
+  if (k < n) {
+    __m128 mk = SSE2_TAIL(n-k);
+    x = _mm_loadu_ps(a+n-4);
+    l4[1] = _mm_sub_epi32(l4[1],
+              _mm_castps_si128(_mm_and_ps(_mm_cmplt_ps(x, p4), mk)));
+    e4[1] = _mm_sub_epi32(e4[1],
+              _mm_castps_si128(_mm_and_ps(_mm_cmpeq_ps(x, p4), mk)));
+  }
+
+  // combine the accumulators and compute the horizontal sums
+  int c[8];
+  _mm_storeu_si128((__m128i*)c,     _mm_add_epi32(l4[0], l4[1]));
+  _mm_storeu_si128((__m128i*)(c+4), _mm_add_epi32(e4[0], e4[1]));
+  *lt = c[0] + c[1] + c[2] + c[3];
+  *eq = c[4] + c[5] + c[6] + c[7];
+}  // spivcnt_sse2()
+
+/*--------------------------------------------------------------------------*/
+
+/* dpivcnt_sse2
+ * ------------
+ * count the values less than and equal to the pivot p
+ * (double precision; SSE2 implementation)
+ */
+inline void dpivcnt_sse2 (const double *a, int n, double p,
+                          int *lt, int *eq)
+{
+  assert(a && (n > 0) && lt && eq);
+
+  __m128d p2 = _mm_set1_pd(p);
+  __m128i l2[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+  __m128i e2[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+  __m128d x;
+
+  // compare 2 vectors to the pivot in each iteration
+  int k = 0;
+  for ( ; k+4 <= n; k += 4)
+    for (int j = 0; j < 2; j++) {
+      x = _mm_loadu_pd(a+k+2*j);
+      l2[j] = _mm_sub_epi64(l2[j], _mm_castpd_si128(_mm_cmplt_pd(x, p2)));
+      e2[j] = _mm_sub_epi64(e2[j], _mm_castpd_si128(_mm_cmpeq_pd(x, p2)));
+    }
+  if (k+2 <= n) {
+    x = _mm_loadu_pd(a+k);
+    l2[0] = _mm_sub_epi64(l2[0], _mm_castpd_si128(_mm_cmplt_pd(x, p2)));
+    e2[0] = _mm_sub_epi64(e2[0], _mm_castpd_si128(_mm_cmpeq_pd(x, p2)));
+    k += 2;
+  }
+
+  // combine the accumulators and compute the horizontal sums
+  long long c[4];
+  _mm_storeu_si128((__m128i*)c,     _mm_add_epi64(l2[0], l2[1]));
+  _mm_storeu_si128((__m128i*)(c+2), _mm_add_epi64(e2[0], e2[1]));
+  int l = (int)(c[0] + c[1]), e = (int)(c[2] + c[3]);
+  if (k < n) {                  // compare the last value (odd n)
+    l += (a[k] < p); e += (a[k] == p); }
+  *lt = l; *eq = e;
+}  // dpivcnt_sse2()
 
 #endif // #ifndef STATS_SSE2_H
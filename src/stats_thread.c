@@ -0,0 +1,206 @@
+/*----------------------------------------------------------------------------
+  File    : stats_thread.c
+  Contents: simple thread-parallel loops for the batch functions
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifdef __linux__
+#define _GNU_SOURCE             // for pthread_setaffinity_np()
+#include <sched.h>
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "stats_thread.h"
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#define MAXTHREADS 256          // maximum number of threads
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef struct {                // --- range of task indices
+  stats_task *task;             // task function
+  void       *data;             // data for the task function
+  int        tid;               // thread index
+  int        beg, end;          // range of task indices
+} range;
+
+typedef struct {                // --- pool of worker threads
+  pthread_t   t[MAXTHREADS];    // worker threads (t[1], ...)
+  unsigned    tgen[MAXTHREADS]; // job generation at start
+  int         nwork;            // number of worker threads
+  const range *r;               // ranges of the current job
+  int         nr;               // number of ranges processed by workers
+  int         pending;          // number of ranges not yet finished
+  unsigned    gen;              // job generation (counter)
+  int         quit;             // whether the workers should terminate
+} pool;
+
+/*----------------------------------------------------------------------------
+  Global Variables
+----------------------------------------------------------------------------*/
+static int pinning = 0;         // whether to pin threads to processors
+
+static pool            P;      // pool of worker threads
+static pthread_mutex_t mtx  = PTHREAD_MUTEX_INITIALIZER; // for P
+static pthread_cond_t  go   = PTHREAD_COND_INITIALIZER;  // new job (quit)
+static pthread_cond_t  done = PTHREAD_COND_INITIALIZER;  // job completed
+static pthread_mutex_t busy = PTHREAD_MUTEX_INITIALIZER; // pool in use
+
+/*----------------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------------*/
+
+static void pin (int tid)
+{                               // --- pin the calling thread to the
+#ifdef __linux__                //     processor with index tid
+  long nproc = sysconf(_SC_NPROCESSORS_ONLN);
+  if (nproc <= 0) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET((size_t)(tid % (int)nproc), &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif                          // (not supported on other systems)
+}  // pin()
+
+/*--------------------------------------------------------------------------*/
+
+static void* worker (void *arg)
+{                               // --- process a range of task indices
+  range *r = (range*)arg;       //     (in a temporary thread)
+  if (pinning && (r->tid > 0)) pin(r->tid);
+  r->task(r->data, r->tid, r->beg, r->end);
+  return NULL;
+}  // worker()
+
+/*--------------------------------------------------------------------------*/
+
+static void* poolworker (void *arg)
+{                               // --- process ranges of task indices
+  int      tid    = (int)(intptr_t)arg;  //     (in a pool thread)
+  int      pinned = 0;
+  pthread_mutex_lock(&mtx);
+  unsigned gen    = P.tgen[tid];
+  for (;;) {                    // wait for a new job
+    while (!P.quit && (P.gen == gen))
+      pthread_cond_wait(&go, &mtx);
+    if (P.quit) break;
+    gen = P.gen;
+    if (tid >= P.nr) continue;  // skip jobs with fewer ranges
+    const range *r = P.r + tid;
+    pthread_mutex_unlock(&mtx);
+    if (pinning && !pinned) {   // pin the thread on first use
+      pin(tid); pinned = 1; }   // (if requested)
+    r->task(r->data, r->tid, r->beg, r->end);
+    pthread_mutex_lock(&mtx);
+    if (--P.pending == 0)       // signal the completion of the job
+      pthread_cond_signal(&done);
+  }
+  pthread_mutex_unlock(&mtx);
+  return NULL;
+}  // poolworker()
+
+/*--------------------------------------------------------------------------*/
+
+static int grow (int nthreads)
+{                               // --- start pool threads (if necessary)
+  while (P.nwork+1 < nthreads) {        // (busy must be held)
+    int tid = P.nwork+1;
+    P.tgen[tid] = P.gen;
+    if (pthread_create(P.t+tid, NULL, poolworker,
+                       (void*)(intptr_t)tid) != 0)
+      break;
+    P.nwork++;
+  }
+  return P.nwork+1;             // return the number of usable threads
+}  // grow()
+
+/*----------------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------------*/
+
+int stats_nthreads (int nthreads)
+{
+  if (nthreads <= 0) {          // if no number of threads is given,
+    long nproc = sysconf(_SC_NPROCESSORS_ONLN);
+    nthreads = (nproc > 0) ? (int)nproc : 1;
+  }                             // use the number of processors
+  return (nthreads > MAXTHREADS) ? MAXTHREADS : nthreads;
+}  // stats_nthreads()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_pin (int on)
+{
+  int old = pinning;
+  pinning = on;
+  return old;
+}  // stats_pin()
+
+/*--------------------------------------------------------------------------*/
+
+int stats_parfor (int nthreads, int ntasks, stats_task *task, void *data)
+{
+  if (ntasks <= 0) return 0;
+  nthreads = stats_nthreads(nthreads);
+  if (nthreads > ntasks) nthreads = ntasks;
+
+  range r[MAXTHREADS];
+  for (int i = 0; i < nthreads; i++) {
+    r[i].task = task; r[i].data = data; r[i].tid = i;
+    r[i].beg  = (int)(((long long)ntasks *  i)    / nthreads);
+    r[i].end  = (int)(((long long)ntasks * (i+1)) / nthreads);
+  }                             // split the task indices into ranges
+  if (nthreads == 1) {          // if there is only one range,
+    worker(r); return 1; }      // process it directly
+
+  if (pthread_mutex_trylock(&busy) == 0) {
+    int nr = grow(nthreads);    // if the pool is available,
+    if (nr > nthreads) nr = nthreads;   // pass the ranges to the workers
+    pthread_mutex_lock(&mtx);
+    P.r = r; P.nr = nr; P.pending = nr-1; P.gen++;
+    pthread_cond_broadcast(&go);
+    pthread_mutex_unlock(&mtx);
+    worker(r);                  // process the first range
+    for (int i = nr; i < nthreads; i++)
+      worker(r+i);              // process the ranges that could not
+    pthread_mutex_lock(&mtx); // be passed to a worker
+    while (P.pending > 0)       // wait for the workers to finish
+      pthread_cond_wait(&done, &mtx);
+    pthread_mutex_unlock(&mtx);
+    pthread_mutex_unlock(&busy);
+    return nthreads;
+  }
+
+  // if the pool is in use (concurrent or nested call), use temporary threads
+  pthread_t t[MAXTHREADS];
+  int       started[MAXTHREADS];
+  for (int i = 1; i < nthreads; i++)  // start the worker threads
+    started[i] = (pthread_create(t+i, NULL, worker, r+i) == 0);
+  worker(r);                          // process the first range
+  for (int i = 1; i < nthreads; i++) {
+    if (started[i]) pthread_join(t[i], NULL);
+    else            worker(r+i);      // process the ranges of threads
+  }                                   // that could not be started
+  return nthreads;
+}  // stats_parfor()
+
+/*--------------------------------------------------------------------------*/
+
+void stats_pool_exit (void)
+{
+  pthread_mutex_lock(&busy);
+  pthread_mutex_lock(&mtx);   // ask the workers to terminate
+  P.quit = 1;
+  pthread_cond_broadcast(&go);
+  pthread_mutex_unlock(&mtx);
+  for (int i = 1; i <= P.nwork; i++)
+    pthread_join(P.t[i], NULL); // wait for the workers to terminate
+  P.nwork = 0;
+  P.quit  = 0;
+  pthread_mutex_unlock(&busy);
+}  // stats_pool_exit()
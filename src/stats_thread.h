@@ -0,0 +1,96 @@
+/*----------------------------------------------------------------------------
+  File    : stats_thread.h
+  Contents: simple thread-parallel loops for the batch functions
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_THREAD_H
+#define STATS_THREAD_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef void (stats_task) (void *data, int tid, int beg, int end);
+// A task function processes the task indices beg, ..., end-1 in the
+// thread with index tid (0 <= tid < number of threads), which can be used
+// to select per-thread buffers.
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+
+/* stats_nthreads
+ * --------------
+ * get the number of threads to be used
+ *
+ * nthreads  requested number of threads (<= 0 -> number of processors)
+ *
+ * returns
+ * the number of threads to be used (>= 1)
+ */
+extern int stats_nthreads (int nthreads);
+
+/* stats_pin
+ * ---------
+ * set whether the worker threads are pinned to processors
+ *
+ * If pinning is enabled, the worker thread with index tid (> 0) is pinned
+ * to the processor with index tid (modulo the number of processors) when
+ * it is first used; pool threads remain pinned until they terminate. As
+ * the assignment of ranges to threads is deterministic, the same range is
+ * then always processed on the same processor (and NUMA node), so pages
+ * that were first touched in a parallel loop with the same number of
+ * threads are accessed locally. The calling thread (tid 0) is not pinned.
+ * Pinning is only supported on Linux and is disabled by default.
+ *
+ * on  whether to pin the worker threads (0 -> no, otherwise yes)
+ *
+ * returns
+ * the previous setting
+ */
+extern int stats_pin (int on);
+
+/* stats_parfor
+ * ------------
+ * process the task indices 0, ..., ntasks-1 in parallel
+ *
+ * The task indices are split into (at most) nthreads contiguous ranges of
+ * (almost) equal size; the range of thread tid is processed by a single
+ * call task(data, tid, beg, end). The assignment of ranges to threads
+ * only depends on ntasks and the number of threads. The calling thread
+ * processes the range of thread 0. The other ranges are passed to a pool
+ * of worker threads, which are started on first use and then wait for
+ * further calls. If the pool is in use (by a concurrent or nested call),
+ * temporary threads are started instead. Ranges for which no thread is
+ * available are processed sequentially by the calling thread.
+ *
+ * nthreads  number of threads (<= 0 -> number of processors)
+ * ntasks    number of task indices
+ * task      task function
+ * data      data passed to the task function
+ *
+ * returns
+ * the number of threads (ranges) used
+ */
+extern int stats_parfor (int nthreads, int ntasks,
+                         stats_task *task, void *data);
+
+/* stats_pool_exit
+ * ---------------
+ * terminate the worker threads of the pool
+ *
+ * This function must be called before the code of the library is
+ * unloaded (e.g., from a function registered with mexAtExit()). The pool
+ * is restarted by the next call of stats_parfor().
+ */
+extern void stats_pool_exit (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // #ifndef STATS_THREAD_H
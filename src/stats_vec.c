@@ -0,0 +1,21 @@
+/*----------------------------------------------------------------------------
+  File    : stats_vec.c
+  Contents: basic statistical functions (generic vector implementations)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#include "stats_vec.h"
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+extern float  ssum_vec      (const float  *a, int n);
+extern float  svarm_vec     (const float  *a, int n, float  m);
+extern void   spivcnt_vec   (const float  *a, int n, float  p,
+                             int *lt, int *eq);
+
+extern double dsum_vec      (const double *a, int n);
+extern double dvarm_vec     (const double *a, int n, double m);
+extern void   dpivcnt_vec   (const double *a, int n, double p,
+                             int *lt, int *eq);
+
+extern double dssum_vec     (const float  *a, int n);
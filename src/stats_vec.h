@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------
+  File    : stats_vec.h
+  Contents: basic statistical functions (generic vector implementations)
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_VEC_H
+#define STATS_VEC_H
+
+#include <assert.h>
+#include <stdint.h>
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#  error "generic vectors require GCC or Clang vector extensions"
+#endif
+
+/*----------------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------------*/
+#ifndef STATS_VEC_BYTES
+#define STATS_VEC_BYTES 16      // vector size in bytes
+#endif                          // (e.g., SSE2, NEON, AltiVec, ...)
+#define STATS_VEC_ACC    4      // number of vector accumulators
+
+/*----------------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------------*/
+typedef float  vfloat  __attribute__((vector_size(STATS_VEC_BYTES),
+                                      may_alias));
+typedef double vdouble __attribute__((vector_size(STATS_VEC_BYTES),
+                                      may_alias));
+// The vector types may alias their element types, so arrays of float
+// and double can be accessed through vfloat and vdouble pointers (after
+// the start address has been aligned to STATS_VEC_BYTES).
+
+typedef int32_t vint32  __attribute__((vector_size(STATS_VEC_BYTES)));
+typedef int64_t vint64  __attribute__((vector_size(STATS_VEC_BYTES)));
+// (results of comparisons of vfloat and vdouble vectors, respectively)
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+// see also stats_vec_real.h
+
+inline double dssum_vec    (const float  *a, int n);
+
+/*----------------------------------------------------------------------------
+  Inline Functions
+----------------------------------------------------------------------------*/
+#ifdef REAL                     // if REAL is already defined, save its
+#  include "real-is-double.inc" // original definition based on the value
+#  undef REAL                   // of REAL_IS_DOUBLE, then undefine it
+#endif
+/*--------------------------------------------------------------------------*/
+#define REAL float              // (re)define REAL to be float
+#define vreal         vfloat
+#define vmask         vint32
+#define sum_vec       ssum_vec
+#define varm_vec      svarm_vec
+#define pivcnt_vec    spivcnt_vec
+#include "stats_vec_real.h"     // single precision versions
+#undef vreal
+#undef vmask
+#undef sum_vec
+#undef varm_vec
+#undef pivcnt_vec
+#undef REAL
+/*--------------------------------------------------------------------------*/
+#undef STATS_VEC_REAL_H         // undef guard to include header a 2nd time
+/*--------------------------------------------------------------------------*/
+#define REAL double             // (re)define REAL to be double
+#define vreal         vdouble
+#define vmask         vint64
+#define sum_vec       dsum_vec
+#define varm_vec      dvarm_vec
+#define pivcnt_vec    dpivcnt_vec
+#include "stats_vec_real.h"     // double precision versions
+#undef vreal
+#undef vmask
+#undef sum_vec
+#undef varm_vec
+#undef pivcnt_vec
+#undef REAL
+/*--------------------------------------------------------------------------*/
+#undef REAL                     // restore original definition of REAL
+#ifdef REAL_IS_DOUBLE           // (if necessary)
+#  if REAL_IS_DOUBLE
+#    define REAL double
+#  else
+#    define REAL float
+#  endif
+#endif
+/*--------------------------------------------------------------------------*/
+
+/* dssum_vec
+ * ---------
+ * compute the sum of single precision values in double precision
+ */
+inline double dssum_vec (const float *a, int n)
+{
+  assert(a && (n >= 0));
+
+  enum { W = (int)(STATS_VEC_BYTES/sizeof(double)) };
+  vdouble s[STATS_VEC_ACC] = { { 0 } };
+  int k = 0;
+  for ( ; k+STATS_VEC_ACC*W <= n; k += STATS_VEC_ACC*W)
+    for (int j = 0; j < STATS_VEC_ACC; j++)
+      for (int l = 0; l < W; l++)     // (converted and added lane by lane,
+        s[j][l] += (double)a[k+j*W+l]; // which compilers vectorize)
+
+  for (int j = 1; j < STATS_VEC_ACC; j++)
+    s[0] += s[j];
+  double r = 0;
+  for (int l = 0; l < W; l++)
+    r += s[0][l];
+  for ( ; k < n; k++)
+    r += (double)a[k];
+  return r;
+}  // dssum_vec()
+
+#endif  // #ifndef STATS_VEC_H
@@ -0,0 +1,150 @@
+/*----------------------------------------------------------------------------
+  File    : stats_vec_real.h
+  Contents: this file is to be included from stats_vec.h
+  Author  : Kristian Loewe
+----------------------------------------------------------------------------*/
+#ifndef STATS_VEC_REAL_H
+#define STATS_VEC_REAL_H
+
+/*----------------------------------------------------------------------------
+  Function Prototypes
+----------------------------------------------------------------------------*/
+inline REAL sum_vec  (const REAL *a, int n);
+inline REAL varm_vec (const REAL *a, int n, REAL m);
+inline void pivcnt_vec (const REAL *a, int n, REAL p, int *lt, int *eq);
+
+/*----------------------------------------------------------------------------
+  Inline Functions
+----------------------------------------------------------------------------*/
+
+/* sum_vec
+ * -------
+ * compute the sum (generic vector implementation)
+ *
+ * Up to W-1 values are added without vectors to align the start address,
+ * where W is the number of values per vector. The main loop then uses
+ * STATS_VEC_ACC independent accumulators (to hide the latency of the
+ * additions) and aligned loads.
+ */
+inline REAL sum_vec (const REAL *a, int n)
+{
+  assert(a && (n > 0));
+
+  enum { W = (int)(STATS_VEC_BYTES/sizeof(REAL)) };
+  REAL s = 0;
+
+  // add values without vectors to achieve alignment
+  while ((n > 0) && ((uintptr_t)a % STATS_VEC_BYTES != 0)) {
+    s += *a++; n--; }
+
+  // add W values to each of the accumulators in each iteration
+  const vreal *v = (const vreal*)a;
+  vreal acc[STATS_VEC_ACC] = { { 0 } };
+  int k = 0;
+  for ( ; k+STATS_VEC_ACC <= n/W; k += STATS_VEC_ACC)
+    for (int j = 0; j < STATS_VEC_ACC; j++)
+      acc[j] += v[k+j];
+  for ( ; k < n/W; k++)         // add the remaining full vectors
+    acc[0] += v[k];
+
+  // combine the accumulators and compute the horizontal sum
+  for (int j = 1; j < STATS_VEC_ACC; j++)
+    acc[0] += acc[j];
+  for (int l = 0; l < W; l++)
+    s += acc[0][l];
+
+  // add the remaining values
+  for (k *= W; k < n; k++)
+    s += a[k];
+
+  return s;
+}  // sum_vec()
+
+/*--------------------------------------------------------------------------*/
+
+/* varm_vec
+ * --------
+ * compute the unbiased sample variance if the mean is m
+ * (generic vector implementation)
+ */
+inline REAL varm_vec (const REAL *a, int n, REAL m)
+{
+  assert(a && (n > 1));
+
+  enum { W = (int)(STATS_VEC_BYTES/sizeof(REAL)) };
+  int  orign = n;
+  REAL v = 0;
+
+  // add values without vectors to achieve alignment
+  while ((n > 0) && ((uintptr_t)a % STATS_VEC_BYTES != 0)) {
+    v += (*a - m) * (*a - m); a++; n--; }
+
+  // add W squared deviations to each of the accumulators per iteration
+  const vreal *x = (const vreal*)a;
+  vreal mv = (vreal){ 0 } + m;
+  vreal acc[STATS_VEC_ACC] = { { 0 } };
+  int k = 0;
+  for ( ; k+STATS_VEC_ACC <= n/W; k += STATS_VEC_ACC)
+    for (int j = 0; j < STATS_VEC_ACC; j++) {
+      vreal d = x[k+j] - mv;
+      acc[j] += d*d;
+    }
+  for ( ; k < n/W; k++) {       // add the remaining full vectors
+    vreal d = x[k] - mv;
+    acc[0] += d*d;
+  }
+
+  // combine the accumulators and compute the horizontal sum
+  for (int j = 1; j < STATS_VEC_ACC; j++)
+    acc[0] += acc[j];
+  for (int l = 0; l < W; l++)
+    v += acc[0][l];
+
+  // add the remaining values
+  for (k *= W; k < n; k++)
+    v += (a[k] - m) * (a[k] - m);
+
+  return v / (REAL)(orign-1);
+}  // varm_vec()
+
+/*--------------------------------------------------------------------------*/
+
+/* pivcnt_vec
+ * ----------
+ * count the values less than and equal to the pivot p
+ * (generic vector implementation)
+ *
+ * The comparisons yield -1 in the lanes where they hold, so the counts
+ * are accumulated by subtracting the comparison results.
+ */
+inline void pivcnt_vec (const REAL *a, int n, REAL p, int *lt, int *eq)
+{
+  assert(a && (n > 0) && lt && eq);
+
+  enum { W = (int)(STATS_VEC_BYTES/sizeof(REAL)) };
+  int l = 0, e = 0;
+
+  // count values without vectors to achieve alignment
+  while ((n > 0) && ((uintptr_t)a % STATS_VEC_BYTES != 0)) {
+    l += (*a < p); e += (*a == p); a++; n--; }
+
+  // compare W values to the pivot in each iteration
+  const vreal *v = (const vreal*)a;
+  vreal pv = (vreal){ 0 } + p;
+  vmask lv = { 0 }, ev = { 0 };
+  int k = 0;
+  for ( ; k < n/W; k++) {
+    lv -= (vmask)(v[k] <  pv);
+    ev -= (vmask)(v[k] == pv);
+  }
+  for (int j = 0; j < W; j++) {
+    l += (int)lv[j]; e += (int)ev[j]; }
+
+  // count the remaining values
+  for (k *= W; k < n; k++) {
+    l += (a[k] < p); e += (a[k] == p); }
+
+  *lt = l; *eq = e;
+}  // pivcnt_vec()
+
+#endif  // #ifndef STATS_VEC_REAL_H